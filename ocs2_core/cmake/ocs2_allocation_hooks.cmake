@@ -0,0 +1,8 @@
+# Library with the heap allocation hooks of ocs2_core/misc/AllocationCounter.h. It is not part of ocs2_core_LIBRARIES such that the
+# counting stays opt-in. Link it explicitly into benchmarks and tests:
+#   target_link_libraries(my_test ${OCS2_ALLOCATION_HOOKS_LIBRARY} ...)
+find_library(OCS2_ALLOCATION_HOOKS_LIBRARY
+  NAMES ocs2_core_allocation_hooks
+  PATHS ${ocs2_core_DIR}/../../../lib
+  NO_DEFAULT_PATH
+)
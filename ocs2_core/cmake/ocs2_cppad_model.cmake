@@ -0,0 +1,49 @@
+# Generates a CppAD model at build time and links it into a static library target, such that the CppAdInterface of the model neither
+# compiles nor loads a library at runtime.
+#
+#   ocs2_add_cppad_model(<target>
+#     MODEL_NAME <model name>
+#     GENERATOR <source>...
+#     [APPROXIMATION_ORDER <Zero|First|Second>]
+#     [LIBRARIES <library>...]
+#   )
+#
+# The GENERATOR sources define the main function of the generator executable. It constructs the CppAdInterface of the model and returns
+# ocs2::cppad_prelinked::generatorMain(argc, argv, adInterface). LIBRARIES are linked to the generator and to <target>, and must contain
+# ocs2_core. The approximation order defaults to Second.
+#
+# Targets that link <target> bind the model with
+#   #include <ocs2_cppad_prelinked/<model name>.h>
+#   ocs2::CppAdInterface adInterface(ocs2::cppad_prelinked::<model name>());
+#
+# The generated functions are global symbols, therefore model names must be unique within an executable.
+function(ocs2_add_cppad_model TARGET)
+  cmake_parse_arguments(ARG "" "MODEL_NAME;APPROXIMATION_ORDER" "GENERATOR;LIBRARIES" ${ARGN})
+  if(NOT ARG_MODEL_NAME OR NOT ARG_GENERATOR)
+    message(FATAL_ERROR "ocs2_add_cppad_model: MODEL_NAME and GENERATOR are required")
+  endif()
+  if(NOT ARG_APPROXIMATION_ORDER)
+    set(ARG_APPROXIMATION_ORDER "Second")
+  endif()
+
+  set(output_dir ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_cppad)
+  set(model_library ${output_dir}/lib${ARG_MODEL_NAME}_prelinked.a)
+  set(function_table ${output_dir}/${ARG_MODEL_NAME}_prelinked.cpp)
+  set(function_table_header ${output_dir}/include/ocs2_cppad_prelinked/${ARG_MODEL_NAME}.h)
+
+  add_executable(${TARGET}_generator ${ARG_GENERATOR})
+  target_link_libraries(${TARGET}_generator ${ARG_LIBRARIES})
+
+  add_custom_command(
+    OUTPUT ${model_library} ${function_table} ${function_table_header}
+    COMMAND ${TARGET}_generator ${output_dir} ${ARG_MODEL_NAME} ${ARG_APPROXIMATION_ORDER}
+    DEPENDS ${TARGET}_generator
+    COMMENT "Generating CppAD model ${ARG_MODEL_NAME}"
+    VERBATIM
+  )
+
+  add_library(${TARGET} STATIC ${function_table} ${function_table_header})
+  target_include_directories(${TARGET} PUBLIC ${output_dir}/include)
+  target_link_libraries(${TARGET} ${ARG_LIBRARIES} ${model_library} m)
+  set_target_properties(${TARGET} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+endfunction()
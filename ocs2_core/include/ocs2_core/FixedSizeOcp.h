@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Fixed-size types of an optimal control problem with NX states and NU inputs. For small systems, the fixed sizes let Eigen allocate the
+ * coefficients on the stack and unroll the matrix operations.
+ *
+ * @tparam NX: The state dimension.
+ * @tparam NU: The input dimension.
+ */
+template <int NX, int NU>
+struct FixedSizeOcp {
+  static constexpr int stateDim = NX;
+  static constexpr int inputDim = NU;
+
+  using state_vector_t = Eigen::Matrix<scalar_t, NX, 1>;
+  using input_vector_t = Eigen::Matrix<scalar_t, NU, 1>;
+  using state_matrix_t = Eigen::Matrix<scalar_t, NX, NX>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, NU, NU>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, NU, NX>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, NX, NU>;
+
+  /**
+   * Fixed-size counterpart of ocs2::ScalarFunctionQuadraticApproximation
+   */
+  struct ScalarFunctionQuadraticApproximation {
+    state_matrix_t dfdxx;
+    input_state_matrix_t dfdux;
+    input_matrix_t dfduu;
+    state_vector_t dfdx;
+    input_vector_t dfdu;
+    scalar_t f = 0.;
+
+    ScalarFunctionQuadraticApproximation() = default;
+
+    /** Copies a dynamic-size approximation. The sizes of its members must match NX and NU. */
+    explicit ScalarFunctionQuadraticApproximation(const ocs2::ScalarFunctionQuadraticApproximation& other)
+        : dfdxx(other.dfdxx), dfdux(other.dfdux), dfduu(other.dfduu), dfdx(other.dfdx), dfdu(other.dfdu), f(other.f) {}
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /** Whether the members of a dynamic-size approximation have the fixed sizes. */
+  static bool hasDimensions(const ocs2::ScalarFunctionQuadraticApproximation& approximation) {
+    return approximation.dfdxx.rows() == NX && approximation.dfdxx.cols() == NX && approximation.dfdux.rows() == NU &&
+           approximation.dfdux.cols() == NX && approximation.dfduu.rows() == NU && approximation.dfduu.cols() == NU &&
+           approximation.dfdx.size() == NX && approximation.dfdu.size() == NU;
+  }
+};
+
+}  // namespace ocs2
@@ -0,0 +1,77 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <mutex>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Process-wide scheduler for the compilation of CppAD code-generated model libraries.
+ *
+ * The jobs run on a bounded pool with one worker per hardware thread, such that independent models are compiled concurrently while
+ * the number of simultaneous compiler processes stays limited. CppAD tapes are recorded in global (per thread) tables which are not
+ * thread-safe in the default CppAD configuration. Jobs must therefore hold tapingMutex() while they record tapes and generate the
+ * sources. Only the compilation, linking and loading of the library run concurrently.
+ */
+class CppAdCompilationScheduler {
+ public:
+  /** Returns the scheduler instance. The worker pool is launched at the first call. */
+  static CppAdCompilationScheduler& instance();
+
+  ~CppAdCompilationScheduler() = default;
+  CppAdCompilationScheduler(const CppAdCompilationScheduler&) = delete;
+  CppAdCompilationScheduler& operator=(const CppAdCompilationScheduler&) = delete;
+
+  /**
+   * Submits a compilation job.
+   *
+   * @param [in] job: The job to run on the pool.
+   * @return Future which becomes ready once the job is done. It rethrows the exception thrown by the job, if any.
+   */
+  std::shared_future<void> submit(std::function<void()> job);
+
+  /** The mutex which serializes CppAD taping and source generation. It does not launch the worker pool. */
+  static std::mutex& tapingMutex();
+
+  /** The number of jobs that can run concurrently. */
+  size_t numWorkers() const { return threadPool_.numThreads(); }
+
+ private:
+  explicit CppAdCompilationScheduler(size_t numWorkers);
+
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
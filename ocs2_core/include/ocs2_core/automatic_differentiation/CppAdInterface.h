@@ -33,18 +33,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <future>
+#include <map>
 #include <string>
+#include <vector>
 
 // CppAD
 #include <cppad/cg.hpp>
 
 // CppAD helpers
 #include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelLibrary.h>
+#include <ocs2_core/automatic_differentiation/CppAdPrelinkedModel.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
 
 namespace ocs2 {
 
+class CppAdDeferredWait;
+
 class CppAdInterface {
  public:
   enum class ApproximationOrder { Zero, First, Second };
@@ -82,10 +89,23 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  /**
+   * Constructor for a model that was generated and linked at build time, see ocs2_add_cppad_model() in cmake/ocs2_cppad_model.cmake.
+   * The models are ready after construction, without compilation or filesystem access. The model function is not available, such that
+   * the interface cannot create new models.
+   *
+   * @param prelinkedModel : The prelinked model, i.e., ocs2::cppad_prelinked::<modelName>() of the generated header.
+   */
+  explicit CppAdInterface(const CppAdPrelinkedModel& prelinkedModel);
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Destructor. Waits for a pending asynchronous model creation.
+   */
+  ~CppAdInterface();
+
+  /**
+   * Copy constructor. The copy shares the loaded library of rhs and only creates its own models. Otherwise, models are reloaded if
+   * available.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -95,12 +115,25 @@ class CppAdInterface {
   CppAdInterface& operator=(CppAdInterface&& rhs) = delete;
 
   /**
-   * Loads earlier created model from disk
+   * Additionally generates and loads single precision versions of the zero and first order models. The function values and Jacobians
+   * are then evaluated in float, the inputs and outputs are converted at the interface. Hessians and the fused evaluation of
+   * getValueAndSparseDerivatives() remain in double precision. Must be set before the models are created or loaded.
+   *
+   * @param singlePrecision : Whether to evaluate the zero and first order models in single precision.
+   */
+  void setSinglePrecision(bool singlePrecision) { singlePrecision_ = singlePrecision; }
+
+  /** Whether the zero and first order models are evaluated in single precision. */
+  bool isSinglePrecision() const { return singlePrecisionModel_ != nullptr; }
+
+  /**
+   * Loads the model that was created last in the library folder from disk. Unlike loadModelsIfAvailable(), it does not check that the
+   * library matches the model function.
    */
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk. The library is stored under its key, see loadModelsIfAvailable().
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -110,11 +143,61 @@ class CppAdInterface {
   /**
    * Load models if they are available on disk. Creates a new library otherwise.
    *
+   * The libraries are content-addressed: the model function is taped and the library key is a hash of the recorded operation graph,
+   * the dimensions, the approximation order and the compile flags. A library is only reused if the index of the library folder contains
+   * its key, so a changed model is recompiled without forcing the recompilation.
+   *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * Tapes the model and generates its sources, then submits the compilation to the CppAdCompilationScheduler and returns. The models of
+   * several interfaces are compiled concurrently this way. The model function is not used after returning. Call waitForModels() before
+   * using the interface.
+   *
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  void createModelsAsync(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
+  /**
+   * Asynchronous version of loadModelsIfAvailable(). The model is taped before returning, the loading or compilation of the library is
+   * submitted to the CppAdCompilationScheduler. Call waitForModels() before using the interface.
+   *
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  void loadModelsIfAvailableAsync(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
+  /**
+   * Generates the model sources and compiles them into a static library that is linked at build time. Used by the generator executables
+   * of ocs2_add_cppad_model(), see cppad_prelinked::generatorMain(). Writes lib<modelName>_prelinked.a, the function table
+   * <modelName>_prelinked.cpp and its header include/ocs2_cppad_prelinked/<modelName>.h to the output folder.
+   *
+   * @param approximationOrder : Order of derivatives to generate
+   * @param outputFolder : Folder to write the library to
+   * @param verbose : Print out extra information
+   */
+  void generatePrelinkedModel(ApproximationOrder approximationOrder, const std::string& outputFolder, bool verbose = true);
+
+  /**
+   * Blocks until the pending asynchronous model creation is done. Rethrows the exception of the compilation job, if any. Returns
+   * immediately if no asynchronous model creation was submitted.
+   */
+  void waitForModels() const;
+
+  /**
+   * Blocks until the pending asynchronous model creations of all the given interfaces are done. Rethrows the first exception of the
+   * compilation jobs, if any, once all the jobs are finished.
+   *
+   * While a CppAdDeferredWait is alive on the calling thread, the jobs are handed to it instead and the call returns immediately.
+   *
+   * @param interfaces : The interfaces to wait for
+   */
+  static void waitForModels(const std::vector<const CppAdInterface*>& interfaces);
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -122,6 +205,15 @@ class CppAdInterface {
    */
   vector_t getFunctionValue(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Evaluates the function into a caller-owned output. Does not allocate once the output has the right size.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] value : y = f(x,p). Only resized if the size does not match.
+   */
+  void getFunctionValue(const vector_t& x, const vector_t& p, vector_t& value) const;
+
   /**
    * Jacobian with gradient of each output w.r.t the variables x in the rows.
    *
@@ -131,6 +223,15 @@ class CppAdInterface {
    */
   matrix_t getJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Evaluates the Jacobian into a caller-owned output. Does not allocate once the output has the right size.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) ). Only resized if the size does not match.
+   */
+  void getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const;
+
   /**
    * Returns the full Gauss-Newton approximation of the function.
    * With auto differentiated function y = f(x,p), the following approximation is made:
@@ -145,6 +246,16 @@ class CppAdInterface {
    */
   ScalarFunctionQuadraticApproximation getGaussNewtonApproximation(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Evaluates the Gauss-Newton approximation into a caller-owned output, see above. Does not allocate once f, dfdx and dfdxx have the
+   * right sizes. The other members of the approximation are left untouched.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] gnApproximation : Quadratic approximation with the values stored in f, dfdx, dfdxx.
+   */
+  void getGaussNewtonApproximation(const vector_t& x, const vector_t& p, ScalarFunctionQuadraticApproximation& gnApproximation) const;
+
   /**
    * Hessian, available per output.
    *
@@ -165,6 +276,81 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Compressed nonzeros of the Jacobian w.r.t the variables x. Use the helpers in cppad_sparsity to accumulate them into the blocks of an
+   * approximation without forming the dense Jacobian.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] nonzeros : Nonzeros in the order of getJacobianNonzeroIndices(). Only resized if the size does not match.
+   */
+  void getSparseJacobian(const vector_t& x, const vector_t& p, vector_t& nonzeros) const;
+
+  /**
+   * Compressed upper triangular nonzeros of the weighted hessian w.r.t the variables x.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] nonzeros : Nonzeros in the order of getHessianNonzeroIndices(). Only resized if the size does not match.
+   */
+  void getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& nonzeros) const;
+
+  /**
+   * Function value and sparse Jacobian from a single fused generated function, such that the forward sweep and the subexpressions shared
+   * by the value and the derivatives are computed once. The fused function is generated for ApproximationOrder::First and Second.
+   * Otherwise, the value and the Jacobian are evaluated separately.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] value : y = f(x,p)
+   * @param [out] jacobianNonzeros : Nonzeros in the order of getJacobianNonzeroIndices().
+   */
+  void getValueAndSparseJacobian(const vector_t& x, const vector_t& p, vector_t& value, vector_t& jacobianNonzeros) const;
+
+  /**
+   * Function value, sparse Jacobian and sparse weighted hessian from a single fused generated function. The fused function is generated
+   * for ApproximationOrder::Second. Otherwise, the value and the derivatives are evaluated separately.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] value : y = f(x,p)
+   * @param [out] jacobianNonzeros : Nonzeros in the order of getJacobianNonzeroIndices().
+   * @param [out] hessianNonzeros : Nonzeros of dd/dxdx(sum_i  w_i*f_i(x,p) ) in the order of getHessianNonzeroIndices().
+   */
+  void getValueAndSparseDerivatives(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& value, vector_t& jacobianNonzeros,
+                                    vector_t& hessianNonzeros) const;
+
+  /**
+   * Batched evaluation of the function at N points. The generated function is called directly for each point, without the
+   * per-point temporaries of getFunctionValue().
+   *
+   * @param x : inputs of size variableDim x N, one point per column
+   * @param p : parameters of size parameterDim x N, one point per column. Ignored if parameterDim is zero.
+   * @param [out] values : y_i = f(x_i, p_i) in the columns of a rangeDim x N matrix. Only resized if the size does not match.
+   */
+  void getFunctionValues(const matrix_t& x, const matrix_t& p, matrix_t& values) const;
+
+  /**
+   * Batched evaluation of the sparse Jacobian at N points.
+   *
+   * @param x : inputs of size variableDim x N, one point per column
+   * @param p : parameters of size parameterDim x N, one point per column. Ignored if parameterDim is zero.
+   * @param [out] nonzeros : Nonzeros of the Jacobian at point i, ordered as in getJacobianNonzeroIndices(), in the columns of a
+   *                         nnz x N matrix. Only resized if the size does not match.
+   */
+  void getSparseJacobians(const matrix_t& x, const matrix_t& p, matrix_t& nonzeros) const;
+
+  /** Name of the model. */
+  const std::string& getModelName() const { return modelName_; }
+
+  /** Indices of the nonzeros of getSparseJacobian(). The pattern is fixed once the models are loaded. */
+  const cppad_sparsity::NonzeroIndices& getJacobianNonzeroIndices() const { return library_->getJacobianNonzeroIndices(); }
+
+  /** Indices of the upper triangular nonzeros of getSparseHessian(). The pattern is fixed once the models are loaded. */
+  const cppad_sparsity::NonzeroIndices& getHessianNonzeroIndices() const { return library_->getHessianNonzeroIndices(); }
+
  private:
   /**
    * Defines library folder names
@@ -194,6 +380,138 @@ class CppAdInterface {
    */
   void setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compiler) const;
 
+  /**
+   * Generates the sources of the library. Must be called with the CppAD taping mutex held.
+   * @param approximationOrder : Order of derivatives to generate
+   * @param fun : taped ad function
+   * @param withLibrarySources : Whether to include the sources of the library functions, which only a shared library needs.
+   * @return The library sources, indexed by file name
+   */
+  std::map<std::string, std::string> generateSources(ApproximationOrder approximationOrder, ad_fun_t& fun, bool withLibrarySources) const;
+
+  /**
+   * Records the tape of the fused function (x, p, w) -> [y; jacobianNonzeros; hessianNonzeros] from the tape of the model. The weights
+   * w and the Hessian are only part of the fused function for ApproximationOrder::Second. Must be called with the CppAD taping mutex held.
+   * @param approximationOrder : Order of derivatives to generate, must not be ApproximationOrder::Zero
+   * @param fun : taped ad function
+   * @return The taped and optimized fused function
+   */
+  std::unique_ptr<ad_fun_t> recordFusedTape(ApproximationOrder approximationOrder, ad_fun_t& fun) const;
+
+  /** Name of the fused model of the value and the Jacobian in the library. */
+  std::string getFusedModelName() const { return modelName_ + "_fused"; }
+
+  /** Name of the fused model of the value, the Jacobian and the weighted Hessian in the library. */
+  std::string getFusedHessianModelName() const { return modelName_ + "_fused_hessian"; }
+
+  /** Name of the single precision model in the library. */
+  std::string getSinglePrecisionModelName() const { return modelName_ + "_float"; }
+
+  /**
+   * Writes the concatenated input and parameter vector into the input buffer.
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @return The concatenated input and parameter vector
+   */
+  Eigen::Ref<const vector_t> setInputBuffer(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p) const;
+
+  /**
+   * Evaluates the function value with the single precision model.
+   * @param xp : concatenated input and parameter vector
+   * @param [out] value : y = f(x,p)
+   */
+  void getSinglePrecisionFunctionValue(const Eigen::Ref<const vector_t>& xp, Eigen::Ref<vector_t> value) const;
+
+  /**
+   * Evaluates the sparse Jacobian with the single precision model.
+   * @param xp : concatenated input and parameter vector
+   * @param [out] nonzeros : Nonzeros in the order of getJacobianNonzeroIndices().
+   */
+  void getSinglePrecisionSparseJacobian(const Eigen::Ref<const vector_t>& xp, Eigen::Ref<vector_t> nonzeros) const;
+
+  /** The tape dependent results needed to load or compile the library of the model. */
+  struct ModelSources {
+    std::string key;
+    std::string cachedLibraryFile;
+    std::map<std::string, std::string> sources;
+  };
+
+  /**
+   * Tapes the model, then loads the library of the model from the cache or compiles it.
+   * @param approximationOrder : Order of derivatives to generate
+   * @param useCache : Whether a library with the same key may be loaded from disk.
+   * @param verbose : Print out extra information
+   */
+  void buildModels(ApproximationOrder approximationOrder, bool useCache, bool verbose);
+
+  /**
+   * Tapes the model and generates its sources, unless a library with the same key is found in the cache.
+   * @param approximationOrder : Order of derivatives to generate
+   * @param useCache : Whether a library with the same key may be loaded from disk.
+   */
+  ModelSources recordModelSources(ApproximationOrder approximationOrder, bool useCache);
+
+  /**
+   * Loads the cached library or compiles the sources. Does not use the model function.
+   * @param modelSources : The output of recordModelSources()
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  void compileModelSources(const ModelSources& modelSources, ApproximationOrder approximationOrder, bool verbose);
+
+  /** Records the model sources and submits their compilation to the CppAdCompilationScheduler. */
+  void submitModelSources(ApproximationOrder approximationOrder, bool useCache, bool verbose);
+
+  /** Waits for all the futures and rethrows the first exception, if any. */
+  static void waitForAll(const std::vector<std::shared_future<void>>& futures);
+
+  /**
+   * Loads the models from a library file
+   * @param libraryFile : Path to the library
+   * @param verbose : Print out extra information
+   */
+  void loadLibrary(const std::string& libraryFile, bool verbose);
+
+  /**
+   * Creates the models of this interface from a loaded library
+   * @param library : The loaded library
+   */
+  void createModelsFromLibrary(std::shared_ptr<const CppAdModelLibrary> library);
+
+  /**
+   * Records the tape of the model function. Must be called with the CppAD taping mutex held.
+   * @return The taped and optimized function
+   */
+  std::unique_ptr<ad_fun_t> recordTape();
+
+  /**
+   * Computes the key of the library of the model.
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @return The key of the library
+   */
+  std::string getLibraryKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Looks up the library of a key in the index of the library folder.
+   * @param key : The key of the library
+   * @return The path to the library, empty if there is no library for the key on disk.
+   */
+  std::string findCachedLibrary(const std::string& key) const;
+
+  /** Human-readable description of the library key for the index. */
+  std::string getLibraryDescription(ApproximationOrder approximationOrder) const;
+
+  /** Path to the index of the library folder. */
+  std::string getIndexFile() const;
+
+  /**
+   * Checks the dimensions of the points of a batched evaluation
+   * @param x : inputs, one point per column
+   * @param p : parameters, one point per column
+   */
+  void checkBatchDimensions(const matrix_t& x, const matrix_t& p) const;
+
   /**
    * Configure the approximation order for the source generator
    * @param approximationOrder
@@ -202,11 +520,6 @@ class CppAdInterface {
    */
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
-  /**
-   * Stores the sparisty nonzeros
-   */
-  void setSparsityNonzeros();
-
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
    * @param fun : taped ad function
@@ -221,17 +534,30 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
-  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
-  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+  // The library is shared with the other interfaces that loaded it, the models are owned by this interface.
+  std::shared_ptr<const CppAdModelLibrary> library_;
+  CppAdModelLibrary::model_ptr_t model_;
+  CppAdModelLibrary::model_ptr_t fusedModel_;         // nullptr if the library has no fused model
+  CppAdModelLibrary::model_ptr_t fusedHessianModel_;  // nullptr if the library has no second order fused model
+  CppAdModelLibrary::single_precision_model_ptr_t singlePrecisionModel_;  // nullptr if evaluated in double precision
+
+  // Scratch buffers of the evaluations, sized once the models are created. Like the models, they belong to this interface, i.e., to
+  // the thread that owns it.
+  mutable vector_t inputBuffer_;  // (x, p, w)
+  mutable vector_t valueBuffer_;
+  mutable vector_t jacobianBuffer_;
+  mutable vector_t fusedBuffer_;
+  mutable Eigen::VectorXf singlePrecisionInputBuffer_;
+  mutable Eigen::VectorXf singlePrecisionOutputBuffer_;
+
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
+  bool singlePrecision_ = false;
 
   // Sizes
   size_t variableDim_;
   size_t parameterDim_;
   size_t rangeDim_ = 0;
-  size_t nnzJacobian_ = 0;
-  size_t nnzHessian_ = 0;
 
   // Names
   std::string modelName_;
@@ -240,6 +566,44 @@ class CppAdInterface {
   std::string tmpName_;
   std::string tmpFolder_;
   std::string libraryName_;
+
+  // Pending asynchronous model creation
+  std::shared_future<void> modelsFuture_;
+
+  friend class CppAdDeferredWait;
+};
+
+/**
+ * Defers the waits of CppAdInterface::waitForModels(interfaces) on the current thread while it is alive, such that the models of
+ * several components (e.g., the dynamics and the kinematics of each end-effector) are compiled concurrently. The components are only
+ * usable after waitAll(). Scopes can be nested, the innermost one collects the jobs.
+ *
+ * Usage:
+ *   CppAdDeferredWait deferredWait;
+ *   auto dynamicsPtr = ...;
+ *   std::vector<std::unique_ptr<EndEffectorKinematics<scalar_t>>> eeKinematics = ...;
+ *   deferredWait.waitAll();
+ */
+class CppAdDeferredWait {
+ public:
+  CppAdDeferredWait();
+
+  /** Waits for the remaining jobs. Their exceptions are discarded. */
+  ~CppAdDeferredWait();
+
+  CppAdDeferredWait(const CppAdDeferredWait&) = delete;
+  CppAdDeferredWait& operator=(const CppAdDeferredWait&) = delete;
+
+  /** Blocks until all the collected jobs are done. Rethrows the first exception of the jobs, if any. */
+  void waitAll();
+
+ private:
+  static thread_local CppAdDeferredWait* current_;
+
+  CppAdDeferredWait* previous_;
+  std::vector<std::shared_future<void>> futures_;
+
+  friend class CppAdInterface;
 };
 
 }  // namespace ocs2
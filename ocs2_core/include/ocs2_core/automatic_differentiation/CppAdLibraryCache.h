@@ -0,0 +1,93 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <ocs2_core/automatic_differentiation/Types.h>
+
+namespace ocs2 {
+
+namespace cppad_library_cache {
+
+/**
+ * Incremental 64 bit FNV-1a hash. Unlike std::hash, the value is stable across processes and builds, which is required to address
+ * libraries on disk.
+ */
+class Hash {
+ public:
+  /** Adds a string to the hash. The length is hashed as well such that the concatenation of fields is unambiguous. */
+  Hash& add(const std::string& data);
+
+  /** Adds an integer to the hash. */
+  Hash& add(uint64_t value);
+
+  /** The hash value as a fixed length hexadecimal string. */
+  std::string toString() const;
+
+ private:
+  void addBytes(const char* data, size_t size);
+
+  uint64_t value_ = 14695981039346656037ULL;
+};
+
+/**
+ * Returns the C code of the zero order forward sweep of a taped function. The code is a canonical representation of the recorded
+ * operation graph, independent of the address space and of the order in which the objects were taped.
+ *
+ * @param fun : function that has been taped already.
+ * @return The generated code.
+ */
+std::string getOperationGraph(CppAD::ADFun<ad_base_t>& fun);
+
+/**
+ * Looks up a library in an index file.
+ *
+ * @param indexFile : Path to the index file.
+ * @param key : The key of the library.
+ * @return The file name of the library, relative to the folder of the index. Empty if the key is not in the index.
+ */
+std::string findLibrary(const std::string& indexFile, const std::string& key);
+
+/**
+ * Adds a library to an index file, or replaces the entry of the key. The index is locked with flock for the read-modify-write and
+ * replaced by an atomic rename, such that concurrent writers in several processes never lose entries and readers never observe a
+ * partially written index.
+ *
+ * @param indexFile : Path to the index file.
+ * @param key : The key of the library.
+ * @param libraryFile : The file name of the library, relative to the folder of the index.
+ * @param description : Human-readable description of the key. Must not contain line breaks.
+ */
+void addLibrary(const std::string& indexFile, const std::string& key, const std::string& libraryFile, const std::string& description);
+
+}  // namespace cppad_library_cache
+}  // namespace ocs2
@@ -0,0 +1,130 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <cppad/cg.hpp>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdPrelinkedModel.h>
+#include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
+
+namespace ocs2 {
+
+/**
+ * A loaded CppAD model library together with the sparsity of its model.
+ *
+ * Libraries are shared through a process-wide registry: all the CppAdInterfaces that load the same library file, e.g. the clones of an
+ * optimal control problem for the worker threads, share one library handle and one copy of the sparsity data. The library is closed
+ * once the last reference is released. The GenericModels hold scratch buffers and are not thread-safe, therefore each interface creates
+ * its own models with createModel(). Prelinked libraries, see CppAdPrelinkedModel, are shared the same way.
+ */
+class CppAdModelLibrary : public std::enable_shared_from_this<CppAdModelLibrary> {
+ public:
+  /** Destroys a model under the lock of its library and keeps the library alive as long as the model. */
+  struct ModelDeleter {
+    std::shared_ptr<const CppAdModelLibrary> library;
+    void operator()(CppAD::cg::GenericModel<scalar_t>* model) const;
+    void operator()(CppAD::cg::GenericModel<float>* model) const;
+  };
+  using model_ptr_t = std::unique_ptr<CppAD::cg::GenericModel<scalar_t>, ModelDeleter>;
+  using single_precision_model_ptr_t = std::unique_ptr<CppAD::cg::GenericModel<float>, ModelDeleter>;
+
+  /**
+   * Returns the loaded library of a file, and loads it if no other interface holds it.
+   *
+   * @param libraryFile : Path to the library. Paths that resolve to the same file share the library.
+   * @param modelName : Name of the model whose sparsity is stored.
+   * @return The shared library.
+   */
+  static std::shared_ptr<const CppAdModelLibrary> load(const std::string& libraryFile, const std::string& modelName);
+
+  /**
+   * Returns the library of a model that was linked at build time. Does not access the filesystem.
+   *
+   * @param prelinkedModel : Function table of the model. Must outlive the library, e.g., the static table of the generated sources.
+   * @return The shared library.
+   */
+  static std::shared_ptr<const CppAdModelLibrary> load(const CppAdPrelinkedModel& prelinkedModel);
+
+  ~CppAdModelLibrary() = default;
+  CppAdModelLibrary(const CppAdModelLibrary&) = delete;
+  CppAdModelLibrary& operator=(const CppAdModelLibrary&) = delete;
+
+  /**
+   * Creates a model of the library. Thread-safe.
+   *
+   * @param modelName : Name of the model.
+   * @return The model, nullptr if the library does not contain the model.
+   */
+  model_ptr_t createModel(const std::string& modelName) const;
+
+  /**
+   * Creates a model of the library whose generated code is in single precision, see CppAdInterface::setSinglePrecision(). Thread-safe.
+   *
+   * @param modelName : Name of the model.
+   * @return The model, nullptr if the library does not contain the model.
+   */
+  single_precision_model_ptr_t createSinglePrecisionModel(const std::string& modelName) const;
+
+  /** Indices of the Jacobian nonzeros of the model. */
+  const cppad_sparsity::NonzeroIndices& getJacobianNonzeroIndices() const { return jacobianNonzeroIndices_; }
+
+  /** Indices of the upper triangular Hessian nonzeros of the model. */
+  const cppad_sparsity::NonzeroIndices& getHessianNonzeroIndices() const { return hessianNonzeroIndices_; }
+
+  /** Path to the library, empty for prelinked libraries. */
+  const std::string& getLibraryFile() const { return libraryFile_; }
+
+ private:
+  CppAdModelLibrary(const std::string& libraryFile, const std::string& modelName);
+  explicit CppAdModelLibrary(const CppAdPrelinkedModel& prelinkedModel);
+
+  /** Returns the library of a registry key, and creates it if no other interface holds it. */
+  static std::shared_ptr<const CppAdModelLibrary> getShared(const std::string& key, const std::function<CppAdModelLibrary*()>& create);
+
+  /** Reads the sparsity of the model. */
+  void setSparsity(CppAD::cg::GenericModel<scalar_t>& model);
+
+  std::string libraryFile_;
+  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;  // nullptr for prelinked libraries
+  const CppAdPrelinkedModel* prelinkedModel_ = nullptr;
+  // The library keeps track of its models in an unsynchronized set
+  mutable std::mutex modelMutex_;
+
+  cppad_sparsity::NonzeroIndices jacobianNonzeroIndices_;
+  cppad_sparsity::NonzeroIndices hessianNonzeroIndices_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ocs2 {
+
+class CppAdInterface;
+
+/**
+ * Function table of a CppAD model library that was generated at build time and linked into the executable, see ocs2_add_cppad_model()
+ * in cmake/ocs2_cppad_model.cmake. The tables are defined in the generated sources and are bound with
+ * CppAdInterface(const CppAdPrelinkedModel&), which neither compiles nor touches the filesystem.
+ */
+struct CppAdPrelinkedModel {
+  std::string modelName;
+  size_t variableDim;
+  size_t parameterDim;
+  /** Names of the models in the library, i.e., the model and its fused model. */
+  std::set<std::string> modelNames;
+  /** Addresses of the generated functions, by symbol name. */
+  std::map<std::string, void*> functions;
+};
+
+namespace cppad_prelinked {
+
+/**
+ * Finds the functions of a model that are defined in generated sources. These are the functions that CppAD looks up in a model library.
+ *
+ * @param modelName : Name of the model.
+ * @param sources : The generated sources, indexed by file name.
+ * @return The symbol names of the defined functions.
+ */
+std::vector<std::string> findModelFunctions(const std::string& modelName, const std::map<std::string, std::string>& sources);
+
+/**
+ * Writes the source with the function table of a prelinked model and the header that declares it. The function table is returned by
+ * ocs2::cppad_prelinked::<modelName>() declared in <outputFolder>/include/ocs2_cppad_prelinked/<modelName>.h.
+ *
+ * @param outputFolder : Folder to write <modelName>_prelinked.cpp and the header to.
+ * @param prelinkedModel : The model, the function addresses are ignored.
+ * @param functionNames : The symbol names of the generated functions.
+ */
+void writeFunctionTable(const std::string& outputFolder, const CppAdPrelinkedModel& prelinkedModel,
+                        const std::vector<std::string>& functionNames);
+
+/**
+ * Main function of the generator executables of ocs2_add_cppad_model(). Generates the prelinked model of the interface with
+ * CppAdInterface::generatePrelinkedModel(). The arguments are <output folder> <model name> <approximation order>, where the
+ * approximation order is one of Zero, First or Second.
+ *
+ * @param argc : Number of command line arguments.
+ * @param argv : Command line arguments.
+ * @param adInterface : The interface of the model. Its model name must match the model name argument.
+ * @return The exit code of the generator.
+ */
+int generatorMain(int argc, char* argv[], CppAdInterface& adInterface);
+
+}  // namespace cppad_prelinked
+}  // namespace ocs2
@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cppad/cg.hpp>
 
+#include <ocs2_core/Types.h>
+
 namespace ocs2 {
 
 namespace cppad_sparsity {
@@ -44,6 +46,16 @@ namespace cppad_sparsity {
  */
 using SparsityPattern = std::vector<std::set<size_t>>;
 
+/**
+ * Row and column index of each nonzero of a compressed sparse matrix, in the order in which the nonzeros are stored.
+ */
+struct NonzeroIndices {
+  std::vector<size_t> rows;
+  std::vector<size_t> cols;
+
+  size_t size() const { return rows.size(); }
+};
+
 /**
  * Gets the Jacobian sparsity pattern of a taped CppAD function.
  * @tparam ad_fun_t : CppAD function type.
@@ -98,5 +110,39 @@ SparsityPattern getHessianVariableSparsity(int variableDim, int parameterDim);
  */
 size_t getNumberOfNonZeros(const SparsityPattern& sparsityPattern);
 
+/**
+ * Lists the nonzeros of a sparsity pattern row by row, in increasing column order within a row.
+ *
+ * @param sparsityPattern
+ * @return indices of the nonzero elements
+ */
+NonzeroIndices getNonzeroIndices(const SparsityPattern& sparsityPattern);
+
+/**
+ * Adds the nonzeros that fall into a block of the sparse matrix to a dense matrix of the size of the block:
+ * block(row - rowOffset, col - colOffset) += nonzeros[i]. Nonzeros outside of the block are skipped.
+ *
+ * @param indices : Indices of the nonzeros.
+ * @param nonzeros : Compressed nonzeros, of size indices.size().
+ * @param rowOffset : First row of the block in the sparse matrix.
+ * @param colOffset : First column of the block in the sparse matrix.
+ * @param block : Dense matrix to accumulate into.
+ */
+void addToBlock(const NonzeroIndices& indices, const vector_t& nonzeros, size_t rowOffset, size_t colOffset, Eigen::Ref<matrix_t> block);
+
+/**
+ * Same as addToBlock, but accumulates into the transpose of the block: block(col - colOffset, row - rowOffset) += nonzeros[i].
+ * For instance, the gradient of a scalar function is accumulated from its Jacobian this way.
+ */
+void addToBlockTransposed(const NonzeroIndices& indices, const vector_t& nonzeros, size_t rowOffset, size_t colOffset,
+                          Eigen::Ref<matrix_t> block);
+
+/**
+ * Same as addToBlock for a symmetric matrix of which only the upper triangular nonzeros are stored. The nonzeros are mirrored, such
+ * that the blocks on, above and below the diagonal can be extracted.
+ */
+void addToSymmetricBlock(const NonzeroIndices& indices, const vector_t& nonzeros, size_t rowOffset, size_t colOffset,
+                         Eigen::Ref<matrix_t> block);
+
 }  // namespace cppad_sparsity
 }  // namespace ocs2
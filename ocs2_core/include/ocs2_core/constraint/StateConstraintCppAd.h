@@ -58,6 +58,14 @@ class StateConstraintCppAd : public StateConstraint {
   /** Get the parameter vector */
   virtual vector_t getParameters(scalar_t time, const PreComputation& /* preComputation */) const { return vector_t(0); };
 
+  /**
+   * Writes the parameter vector into the given output, which the evaluations keep as a member. Override this instead of
+   * getParameters() to avoid allocating a new vector on every evaluation. Defaults to getParameters().
+   */
+  virtual void updateParameters(scalar_t time, const PreComputation& preComputation, vector_t& parameters) const {
+    parameters = getParameters(time, preComputation);
+  }
+
   /** Constraint evaluation */
   vector_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
@@ -73,6 +81,14 @@ class StateConstraintCppAd : public StateConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  // Scratch buffers of the evaluations. Every worker evaluates its own clone of the constraint, such that they are not shared between
+  // threads.
+  mutable vector_t tapedTimeState_;
+  mutable vector_t parameters_;
+  mutable vector_t weights_;
+  mutable vector_t jacobianNonzeros_;
+  mutable vector_t hessianNonzeros_;
 };
 
 }  // namespace ocs2
@@ -59,6 +59,14 @@ class StateInputConstraintCppAd : public StateInputConstraint {
   /** Get the parameter vector */
   virtual vector_t getParameters(scalar_t time, const PreComputation& /* preComputation */) const { return vector_t(0); };
 
+  /**
+   * Writes the parameter vector into the given output, which the evaluations keep as a member. Override this instead of
+   * getParameters() to avoid allocating a new vector on every evaluation. Defaults to getParameters().
+   */
+  virtual void updateParameters(scalar_t time, const PreComputation& preComputation, vector_t& parameters) const {
+    parameters = getParameters(time, preComputation);
+  }
+
   /** Constraint evaluation */
   vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& /* preComputation */) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
@@ -75,6 +83,14 @@ class StateInputConstraintCppAd : public StateInputConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  // Scratch buffers of the evaluations. Every worker evaluates its own clone of the constraint, such that they are not shared between
+  // threads.
+  mutable vector_t tapedTimeStateInput_;
+  mutable vector_t parameters_;
+  mutable vector_t weights_;
+  mutable vector_t jacobianNonzeros_;
+  mutable vector_t hessianNonzeros_;
 };
 
 }  // namespace ocs2
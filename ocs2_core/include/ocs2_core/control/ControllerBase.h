@@ -36,6 +36,10 @@ namespace ocs2 {
 
 /**
  * The base class for all controllers.
+ *
+ * Thread safety: computeInput() of the controllers in ocs2_core does not modify the controller, hence it can be called concurrently on
+ * the same instance, e.g., by the worker threads of a rollout. The modifiers (setController, concatenate, clear, etc.) must not run
+ * concurrently with any other method. Derived controllers that keep state in computeInput() must state so in their documentation.
  */
 class ControllerBase {
  public:
@@ -54,6 +58,17 @@ class ControllerBase {
    */
   virtual vector_t computeInput(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * @brief Computes the control command at a given time and state into the given vector.
+   * Controllers that support it override this method to avoid heap allocations when the size of u is already correct.
+   * The default implementation calls computeInput(t, x).
+   *
+   * @param [in] t: Current time.
+   * @param [in] x: Current state.
+   * @param [out] u: Current input.
+   */
+  virtual void computeInput(scalar_t t, const vector_t& x, vector_t& u) { u = computeInput(t, x); }
+
   /**
    * @brief Merges this controller with another controller that comes active later in time
    * This method is typically used to merge controllers from multiple time partitions.
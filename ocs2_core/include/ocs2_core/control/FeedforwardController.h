@@ -83,6 +83,7 @@ class FeedforwardController final : public ControllerBase {
    */
   void setController(const scalar_array_t& controllerTime, const vector_array_t& controllerFeedforward);
 
+  using ControllerBase::computeInput;
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
   void concatenate(const ControllerBase* nextController, int index, int length) override;
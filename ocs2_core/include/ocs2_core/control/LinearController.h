@@ -79,6 +79,22 @@ class LinearController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  /**
+   * Computes u = alpha * (b0 + K0 * x) + (1 - alpha) * (b1 + K1 * x) without forming the interpolated gain. It does not allocate if
+   * the size of u is already correct.
+   */
+  void computeInput(scalar_t t, const vector_t& x, vector_t& u) override;
+
+  /**
+   * Computes the inputs for a sequence of times and states, e.g., of a rollout. Increasing times are looked up in constant time.
+   * It does not allocate if inputTrajectory already has the correct sizes.
+   *
+   * @param [in] timeTrajectory: The query times.
+   * @param [in] stateTrajectory: The states at the query times.
+   * @param [out] inputTrajectory: The inputs.
+   */
+  void computeInputs(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
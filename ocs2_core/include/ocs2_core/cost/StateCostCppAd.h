@@ -61,6 +61,15 @@ class StateCostCppAd : public StateCost {
     return vector_t(0);
   };
 
+  /**
+   * Writes the parameter vector into the given output, which the evaluations keep as a member. Override this instead of
+   * getParameters() to avoid allocating a new vector on every evaluation. Defaults to getParameters().
+   */
+  virtual void updateParameters(scalar_t time, const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                vector_t& parameters) const {
+    parameters = getParameters(time, targetTrajectories, preComputation);
+  }
+
   /* Cost evaluation */
   scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
                     const PreComputation& preComp) const override;
@@ -76,6 +85,14 @@ class StateCostCppAd : public StateCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  // Scratch buffers of the evaluations. Every worker evaluates its own clone of the cost, such that they are not shared between threads.
+  const vector_t weights_ = vector_t::Ones(1);
+  mutable vector_t tapedTimeState_;
+  mutable vector_t parameters_;
+  mutable vector_t value_;
+  mutable vector_t jacobianNonzeros_;
+  mutable vector_t hessianNonzeros_;
 };
 
 }  // namespace ocs2
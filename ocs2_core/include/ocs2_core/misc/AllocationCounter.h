@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+namespace benchmark {
+
+/** Number and size of heap allocations. */
+struct AllocationStatistics {
+  size_t numAllocations = 0;
+  size_t numBytes = 0;
+};
+
+/**
+ * Returns whether the heap allocation hooks are installed, i.e., whether the executable is linked against the
+ * ocs2_core_allocation_hooks library. Without the hooks, all the allocation statistics remain at zero.
+ */
+bool isAllocationCounterInstalled();
+
+/** Returns the number and size of all heap allocations of the process (all threads) since it started. */
+AllocationStatistics getAllocationStatistics();
+
+namespace internal {
+/** Called by the allocation hooks. */
+void markAllocationCounterInstalled();
+void countAllocation(size_t numBytes);
+}  // namespace internal
+
+/**
+ * Allocation counter that can be repeatedly started and stopped, with the same interface as RepeatedTimer. Statistics are
+ * collected for all measured intervals. Since the underlying counters are process-wide, allocations of worker threads
+ * are attributed to the interval as well.
+ */
+class RepeatedAllocationCounter {
+ public:
+  /**
+   *  Reset the counter statistics
+   */
+  void reset() {
+    numMeasuredIntervals_ = 0;
+    total_ = AllocationStatistics();
+    maxIntervalAllocations_ = 0;
+    lastInterval_ = AllocationStatistics();
+  }
+
+  /**
+   *  Start counting an interval
+   */
+  void startCounter() { start_ = getAllocationStatistics(); }
+
+  /**
+   * Stop counting of an interval
+   */
+  void endCounter() {
+    const auto end = getAllocationStatistics();
+    lastInterval_.numAllocations = end.numAllocations - start_.numAllocations;
+    lastInterval_.numBytes = end.numBytes - start_.numBytes;
+    maxIntervalAllocations_ = std::max(maxIntervalAllocations_, lastInterval_.numAllocations);
+    total_.numAllocations += lastInterval_.numAllocations;
+    total_.numBytes += lastInterval_.numBytes;
+    numMeasuredIntervals_++;
+  }
+
+  /**
+   * @return Number of intervals that were measured
+   */
+  int getNumMeasuredIntervals() const { return numMeasuredIntervals_; }
+
+  /**
+   * @return Total number of allocations and bytes of the measured intervals
+   */
+  const AllocationStatistics& getTotal() const { return total_; }
+
+  /**
+   * @return Number of allocations and bytes of the last measured interval
+   */
+  const AllocationStatistics& getLastInterval() const { return lastInterval_; }
+
+  /**
+   * @return Maximum number of allocations of a single interval
+   */
+  size_t getMaxIntervalAllocations() const { return maxIntervalAllocations_; }
+
+  /**
+   * @return Average number of allocations of all measured intervals
+   */
+  scalar_t getAverageAllocations() const { return static_cast<scalar_t>(total_.numAllocations) / numMeasuredIntervals_; }
+
+  /**
+   * @return Average number of allocated bytes of all measured intervals
+   */
+  scalar_t getAverageBytes() const { return static_cast<scalar_t>(total_.numBytes) / numMeasuredIntervals_; }
+
+ private:
+  int numMeasuredIntervals_ = 0;
+  AllocationStatistics total_;
+  size_t maxIntervalAllocations_ = 0;
+  AllocationStatistics lastInterval_;
+  AllocationStatistics start_;
+};
+
+/** Formats the average allocations per interval of the counter as "<allocations> (<kilobytes> [kB])". */
+std::string toString(const RepeatedAllocationCounter& counter);
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,130 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * A trajectory of vectors stored in a single contiguous buffer. Node i occupies the first size(i) entries of the i-th column of a
+ * (stride x numNodes) column-major block, where the stride is the largest node dimension. The padding entries are kept at zero such
+ * that whole-trajectory operations (norms, increments) can be performed on the flat buffer.
+ *
+ * The nodes are accessed through Eigen::Map views. Unlike vector_array_t, the dimension of a node is fixed by the layout, i.e.,
+ * assignments to a node must match its size.
+ *
+ * Currently used for the PipgSolver iterates. PrimalSolution and the multiple-shooting solvers still store vector_array_t; they can
+ * be converted through the vector_array_t constructor and toVectorArray().
+ */
+class ContiguousTrajectory {
+ public:
+  using node_t = Eigen::Map<vector_t>;
+  using const_node_t = Eigen::Map<const vector_t>;
+  using flat_t = Eigen::Map<vector_t>;
+  using const_flat_t = Eigen::Map<const vector_t>;
+
+  /** Default constructor. */
+  ContiguousTrajectory() = default;
+
+  /** Constructs a zero trajectory with the given node dimensions. */
+  explicit ContiguousTrajectory(const std::vector<int>& sizes) { resize(sizes); }
+
+  /** Conversion from vector_array_t. */
+  explicit ContiguousTrajectory(const vector_array_t& trajectory) { assign(trajectory); }
+
+  /**
+   * Sets the node dimensions and zeros the whole trajectory. The buffer is only reallocated if the new layout does not fit in it.
+   *
+   * @param [in] sizes: The dimension of each node.
+   */
+  void resize(const std::vector<int>& sizes);
+
+  /** Copies the given trajectory into the buffer, adapting the layout if required. */
+  void assign(const vector_array_t& trajectory);
+
+  /** Copies the trajectory into the given vector_array_t. Nodes of the output with matching dimension are not reallocated. */
+  void toVectorArray(vector_array_t& trajectory) const;
+
+  /** Returns a copy of the trajectory as vector_array_t. */
+  vector_array_t toVectorArray() const {
+    vector_array_t trajectory;
+    toVectorArray(trajectory);
+    return trajectory;
+  }
+
+  /** Sets all the nodes to zero. */
+  void setZero() { flat().setZero(); }
+
+  /** Returns true if the other trajectory has the same number of nodes and node dimensions. */
+  bool hasSameLayout(const ContiguousTrajectory& other) const { return stride_ == other.stride_ && sizes_ == other.sizes_; }
+
+  /** Swaps the content and the layout with the other trajectory. No data is copied. */
+  void swap(ContiguousTrajectory& other) {
+    std::swap(stride_, other.stride_);
+    sizes_.swap(other.sizes_);
+    storage_.swap(other.storage_);
+  }
+
+  /** Number of nodes. */
+  size_t size() const { return sizes_.size(); }
+
+  /** Whether the trajectory has no nodes. */
+  bool empty() const { return sizes_.empty(); }
+
+  /** Dimension of node i. */
+  int size(size_t i) const { return sizes_[i]; }
+
+  /** Node dimensions. */
+  const std::vector<int>& sizes() const { return sizes_; }
+
+  /** Distance between the first entries of two consecutive nodes in the buffer. */
+  int stride() const { return stride_; }
+
+  /** View of node i. */
+  node_t operator[](size_t i) { return node_t(storage_.data() + i * stride_, sizes_[i]); }
+  const_node_t operator[](size_t i) const { return const_node_t(storage_.data() + i * stride_, sizes_[i]); }
+
+  /** View of the whole buffer including the (zero) padding. */
+  flat_t flat() { return flat_t(storage_.data(), stride_ * sizes_.size()); }
+  const_flat_t flat() const { return const_flat_t(storage_.data(), stride_ * sizes_.size()); }
+
+ private:
+  int stride_ = 0;
+  std::vector<int> sizes_;
+  vector_t storage_;
+};
+
+/** Swaps two contiguous trajectories. */
+inline void swap(ContiguousTrajectory& lhs, ContiguousTrajectory& rhs) {
+  lhs.swap(rhs);
+}
+
+}  // namespace ocs2
@@ -53,6 +53,31 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Cursor for sequential lookups of time segments. It remembers the segment of the last lookup and advances it, which makes
+ * monotonic sequences of queries (rollouts, sweeps over a horizon) constant time per lookup. Jumps fall back to a binary search.
+ * The result is always identical to timeSegment(), also if the time array changes between calls.
+ *
+ * A cursor holds mutable state, hence it should not be shared between threads.
+ */
+class TimeSegmentCursor {
+ public:
+  /**
+   * Get the interval index and interpolation coefficient alpha, same as timeSegment(enquiryTime, timeArray).
+   *
+   * @param [in] enquiryTime: The enquiry time for interpolation.
+   * @param [in] timeArray: interpolation time array.
+   * @return {index, alpha}
+   */
+  index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
+
+  /** Restarts the search from the beginning of the time array. */
+  void reset() { hint_ = 0; }
+
+ private:
+  int hint_ = 0;
+};
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -92,6 +117,35 @@ Data interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataA
 template <typename Data, class Alloc>
 Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray);
 
+/**
+ * Same as interpolate(indexAlpha, dataArray), but writes the result into the given output. For Eigen types, the output is not
+ * reallocated if it already has the size of the result.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: vector of data
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& result);
+
+/**
+ * Same as interpolate(enquiryTime, timeArray, dataArray), but writes the result into the given output. For Eigen types, the output is
+ * not reallocated if it already has the size of the result.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray, Data& result);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
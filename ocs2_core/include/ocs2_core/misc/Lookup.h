@@ -91,6 +91,45 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ * Same as findIndexInTimeArray, but starts the search from the index of a previous lookup. For monotonic sequences of queries,
+ * the index is found in a few linear steps from the hint. Larger jumps fall back to a binary search on the remaining side of
+ * the hint. The result is always identical to findIndexInTimeArray, for any value of the hint.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param [in, out] hint : index of a previous lookup. It is updated to the returned index.
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int& hint) {
+  constexpr int maxNumLinearSteps = 4;
+  const int size = static_cast<int>(timeArray.size());
+  int index = std::min(std::max(hint, 0), size);
+
+  // the result is the first index with time <= timeArray[index]
+  for (int step = 0; step < maxNumLinearSteps; step++) {
+    if (index < size && timeArray[index] < time) {
+      ++index;
+    } else if (index > 0 && !(timeArray[index - 1] < time)) {
+      --index;
+    } else {
+      hint = index;
+      return index;
+    }
+  }
+
+  const auto first = timeArray.begin();
+  if (index < size && timeArray[index] < time) {
+    index = static_cast<int>(std::lower_bound(first + index + 1, timeArray.end(), time) - first);
+  } else if (index > 0 && !(timeArray[index - 1] < time)) {
+    index = static_cast<int>(std::lower_bound(first, first + index - 1, time) - first);
+  }
+  hint = index;
+  return index;
+}
+
 /**
  *  Find interval into a sorted time Array
  *
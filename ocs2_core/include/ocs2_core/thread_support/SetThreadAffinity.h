@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * Pins the input thread to a set of CPU cores. The cores can also be isolated ones (e.g., through the isolcpus kernel parameter),
+ * in which case the thread is the only one scheduled on them.
+ *
+ * @param cpuSet: The indices of the allowed CPU cores. An empty set leaves the affinity of the thread unchanged.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpuSet, pthread_t thread) {
+  if (cpuSet.empty()) {
+    return;
+  }
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (const auto cpu : cpuSet) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      std::cerr << "WARNING: Ignoring invalid CPU core index " << cpu << " for the thread affinity." << std::endl;
+      continue;
+    }
+    CPU_SET(cpu, &cpus);
+  }
+
+  if (CPU_COUNT(&cpus) > 0 && pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpus) != 0) {
+    std::cerr << "WARNING: Failed to set threads affinity (one possible reason could be that the requested "
+                 "cores are not available to this process.)"
+              << std::endl;
+  }
+}
+
+/**
+ * Pins the input thread to a set of CPU cores.
+ *
+ * @param cpuSet: The indices of the allowed CPU cores. An empty set leaves the affinity of the thread unchanged.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpuSet, std::thread& thread) {
+  setThreadAffinity(cpuSet, thread.native_handle());
+}
+
+/**
+ * Pins the thread this function is called from to a set of CPU cores.
+ *
+ * @param cpuSet: The indices of the allowed CPU cores. An empty set leaves the affinity of the thread unchanged.
+ */
+inline void setThisThreadAffinity(const std::vector<int>& cpuSet) {
+  setThreadAffinity(cpuSet, pthread_self());
+}
+
+/**
+ * Pins the i-th worker thread of a pool to a single core of the given list. If there are more workers than cores, the cores
+ * are assigned round robin.
+ *
+ * @param cpuAffinity: The list of CPU cores of the pool. An empty list leaves the affinity of the thread unchanged.
+ * @param workerIndex: The index of the worker in the pool.
+ * @param thread: A reference to the tread.
+ */
+inline void setWorkerThreadAffinity(const std::vector<int>& cpuAffinity, size_t workerIndex, std::thread& thread) {
+  if (!cpuAffinity.empty()) {
+    setThreadAffinity({cpuAffinity[workerIndex % cpuAffinity.size()]}, thread);
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace ocs2 {
+
+/**
+ * A reusable barrier for a fixed number of participants. A waiting participant first spins for a configurable number of iterations,
+ * which keeps the release latency low for tightly synchronized loops, and then parks on a condition variable such that idle threads do
+ * not burn CPU time.
+ */
+class SpinBarrier {
+ public:
+  /** The default number of spin iterations before a waiting participant is parked. */
+  static constexpr size_t defaultSpinIterations = 20000;
+
+  /**
+   * Constructor
+   *
+   * @param [in] numParticipants: The number of participants that have to arrive before the barrier is released.
+   * @param [in] spinIterations: The number of spin iterations before a waiting participant is parked. If there are more participants
+   *                             than hardware threads, the participants are parked right away, since spinning would only delay the
+   *                             participants which have not arrived yet.
+   */
+  explicit SpinBarrier(size_t numParticipants, size_t spinIterations = defaultSpinIterations);
+
+  SpinBarrier(const SpinBarrier&) = delete;
+  SpinBarrier& operator=(const SpinBarrier&) = delete;
+
+  /**
+   * Arrives at the barrier and waits until all participants have arrived.
+   *
+   * @return true for exactly one participant of each phase, i.e., the last one to arrive.
+   */
+  bool arriveAndWait() {
+    return arriveAndWait([] {});
+  }
+
+  /**
+   * Arrives at the barrier and waits until all participants have arrived. The last participant to arrive runs the completion function
+   * before the others are released, which makes it a cheap serial section between two parallel sections.
+   *
+   * @param [in] completion: Function with signature void() which is called by the last participant. It must not throw.
+   * @return true for exactly one participant of each phase, i.e., the last one to arrive.
+   */
+  template <typename Completion>
+  bool arriveAndWait(Completion&& completion) {
+    const auto generation = generation_.load(std::memory_order_acquire);
+    if (numRemaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      completion();
+      numRemaining_.store(numParticipants_, std::memory_order_relaxed);
+      release();
+      return true;
+    } else {
+      waitForRelease(generation);
+      return false;
+    }
+  }
+
+  /** Get the number of participants. */
+  size_t numParticipants() const { return static_cast<size_t>(numParticipants_); }
+
+ private:
+  void release();
+  void waitForRelease(uint32_t generation);
+
+  const int numParticipants_;
+  const size_t spinIterations_;
+
+  std::atomic_int numRemaining_;
+  std::atomic<uint32_t> generation_{0};
+  std::atomic_int numParked_{0};
+
+  std::mutex parkingLock_;
+  std::condition_variable parkingCondition_;
+};
+
+}  // namespace ocs2
@@ -29,17 +29,31 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace ocs2 {
 
 /**
  * Thread pool class to execute tasks on multiple threads.
+ *
+ * Each worker owns a task deque. Tasks submitted by run() are pushed to one of the deques; a worker pops tasks from the back of
+ * its own deque and steals from the front of the other deques when it runs out of work.
+ *
+ * runParallel() and parallelFor() do not go through the task deques. They publish a pre-allocated job descriptor which splits an
+ * index range into one contiguous block per participant (the workers and the calling thread). Participants consume their own block
+ * from the front and steal half of the remaining indices of another block from the back once their own block is exhausted. In
+ * steady state, these calls neither allocate memory nor create futures.
  */
 class ThreadPool {
  public:
@@ -48,8 +62,10 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] cpuAffinity: The CPU cores of the pool. The i-th worker thread is pinned to the core cpuAffinity[i % size]. The
+   *                          calling thread is not pinned. If empty, the threads are not pinned.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, const std::vector<int>& cpuAffinity = {});
 
   /**
    * Destructor
@@ -70,15 +86,36 @@ class ThreadPool {
   /**
    * Helper function to run a task N times parallel with the help of the pool.
    * - 1 task will run in the calling thread with ID = nThreads.
-   * - N-1 tasks will run on the threadpool with ID in [0, nThreads-1].
+   * - N-1 tasks will run on the threadpool with ID in [0, nThreads-1]. Tasks which are not picked up by the workers in time are
+   *   executed by the calling thread (ID = nThreads) after its own task.
    *
-   * @note This is a blocking operation, returns when all tasks are completed.
+   * @note This is a blocking operation, returns when all tasks are completed. The first exception thrown by any of the tasks is
+   * rethrown in the calling thread.
    * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex.
+   * @warning The same taskFunction object is invoked concurrently from several threads.
    *
-   * @param [in] taskFunction: task function to run in the pool.
+   * @param [in] taskFunction: task function to run in the pool. It takes the worker index as argument.
    * @param [in] N: number of times to run taskFunction in parallel.
    */
-  void runParallel(std::function<void(int)> taskFunction, int N);
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction, int N);
+
+  /**
+   * Helper function to process the index range [begin, end) in parallel with the help of the pool. The range is split into one
+   * contiguous block per worker (including the calling thread). Each block is consumed in chunks of "grain" indices, and idle workers
+   * steal from the back of the other blocks.
+   *
+   * @note This is a blocking operation, returns when all indices are processed. The first exception thrown by taskFunction is
+   * rethrown in the calling thread and the remaining indices are skipped.
+   *
+   * @param [in] begin: The first index of the range.
+   * @param [in] end: One past the last index of the range.
+   * @param [in] grain: The number of consecutive indices that a worker claims at once (at least 1).
+   * @param [in] taskFunction: task function with signature void(int workerIndex, int index). The worker index is in [0, nThreads],
+   *                           where nThreads refers to the calling thread.
+   */
+  template <typename Functor>
+  void parallelFor(int begin, int end, int grain, Functor&& taskFunction);
 
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
@@ -89,6 +126,19 @@ class ThreadPool {
   template <typename Functor>
   struct Task;
 
+  struct WorkerQueue;
+
+  struct ParallelJob;
+
+  /** Type-erased body of a parallel job. Processes the indices [begin, end) on the worker with the given index. */
+  using job_body_t = void (*)(void* functorPtr, int workerIndex, int begin, int end);
+
+  template <typename Functor>
+  static void invokeRepeatedly(void* functorPtr, int workerIndex, int begin, int end);
+
+  template <typename Functor>
+  static void invokeForEach(void* functorPtr, int workerIndex, int begin, int end);
+
   /**
    * Thread worker loop
    *
@@ -103,11 +153,49 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  /** Pops a task from the back of the worker's own deque or steals one from the front of another deque. */
+  std::unique_ptr<TaskBase> popTask(int workerIndex);
 
-  std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
-  std::condition_variable taskQueueCondition_;
-  std::mutex taskQueueLock_;
+  /**
+   * Publishes a parallel job over the index range [begin, end) and wakes up the workers.
+   *
+   * @param [in] body: The type-erased job body.
+   * @param [in] functorPtr: Pointer to the task function which is passed to the body.
+   * @param [in] begin: The first index of the range.
+   * @param [in] end: One past the last index of the range.
+   * @param [in] grain: The number of consecutive indices that a worker claims at once.
+   * @param [in] includeCaller: Whether the calling thread gets an initial block of the range.
+   * @param [in] skipAfterException: Whether the remaining indices are skipped once an exception is thrown.
+   * @return The published job.
+   */
+  ParallelJob& publishJob(job_body_t body, void* functorPtr, int begin, int end, int grain, bool includeCaller, bool skipAfterException);
+
+  /**
+   * Lets the calling thread help with the remaining work of the job, waits for its completion and recycles the job. Rethrows the
+   * caller exception, if any, or else the first exception thrown by the workers.
+   */
+  void completeJob(ParallelJob& job, std::exception_ptr callerException);
+
+  /** Processes blocks of the job on the given participant slot until no more work can be claimed or stolen. */
+  static void executeJob(ParallelJob& job, int slot, int workerIndex);
+
+  /** Registers the worker to the first active job it has not joined yet. Must be called with jobsLock_ held. */
+  ParallelJob* joinActiveJob(int workerIndex);
+
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop
+
+  // Tasks submitted by run()
+  std::vector<std::unique_ptr<WorkerQueue>> workerQueues_;
+  std::atomic_int numQueuedTasks_{0};  // incremented with jobsLock_ held
+  std::atomic_size_t nextQueueIndex_{0};
+
+  // Parallel jobs submitted by runParallel() and parallelFor(), protected by jobsLock_
+  ParallelJob* activeJobs_{nullptr};
+  std::vector<std::unique_ptr<ParallelJob>> jobStorage_;
+  std::vector<ParallelJob*> freeJobs_;
+
+  std::condition_variable workerCondition_;
+  std::mutex jobsLock_;
 
   std::vector<std::thread> workerThreads_;
 };
@@ -154,4 +242,77 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::runParallel(Functor&& taskFunction, int N) {
+  using functor_t = typename std::remove_reference<Functor>::type;
+  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
+
+  if (N <= 1 || workerThreads_.empty()) {
+    for (int i = 0; i < std::max(N, 1); ++i) {
+      taskFunction(workerId);
+    }
+    return;
+  }
+
+  // Launch N - 1 tasks in helper threads
+  auto* functorPtr = const_cast<void*>(static_cast<const void*>(std::addressof(taskFunction)));
+  ParallelJob& job = publishJob(&invokeRepeatedly<functor_t>, functorPtr, 0, N - 1, 1, false, false);
+
+  // Execute one instance in this thread.
+  std::exception_ptr callerException;
+  try {
+    taskFunction(workerId);
+  } catch (...) {
+    callerException = std::current_exception();
+  }
+
+  // Help with the remaining tasks and wait for helpers to finish.
+  completeJob(job, std::move(callerException));
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::parallelFor(int begin, int end, int grain, Functor&& taskFunction) {
+  using functor_t = typename std::remove_reference<Functor>::type;
+  const auto workerId = static_cast<int>(numThreads());
+
+  if (end - begin <= std::max(grain, 1) || workerThreads_.empty()) {
+    for (int i = begin; i < end; ++i) {
+      taskFunction(workerId, i);
+    }
+    return;
+  }
+
+  auto* functorPtr = const_cast<void*>(static_cast<const void*>(std::addressof(taskFunction)));
+  ParallelJob& job = publishJob(&invokeForEach<functor_t>, functorPtr, begin, end, std::max(grain, 1), true, true);
+  completeJob(job, nullptr);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::invokeRepeatedly(void* functorPtr, int workerIndex, int begin, int end) {
+  auto& taskFunction = *static_cast<Functor*>(functorPtr);
+  for (int i = begin; i < end; ++i) {
+    taskFunction(workerIndex);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::invokeForEach(void* functorPtr, int workerIndex, int begin, int end) {
+  auto& taskFunction = *static_cast<Functor*>(functorPtr);
+  for (int i = begin; i < end; ++i) {
+    taskFunction(workerIndex, i);
+  }
+}
+
 }  // namespace ocs2
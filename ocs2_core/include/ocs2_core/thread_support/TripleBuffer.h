@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ocs2 {
+
+/**
+ * A wait-free single-producer single-consumer exchange of values through three buffers.
+ *
+ * The producer fills the write buffer and publishes it. The consumer reads the active buffer, which remains constant until it calls
+ * updateFromBuffer() to swap in the most recently published value. The third buffer is handed back and forth between the two sides
+ * with a single atomic exchange, so neither side ever blocks, and no value is copied or allocated by the exchange itself. Values that
+ * are published while the consumer does not update are overwritten, i.e., the consumer always gets the latest value.
+ *
+ * @note At most one thread may act as the producer (getWriteBuffer(), publish()) and one as the consumer (get(), updateFromBuffer())
+ * at any time.
+ *
+ * @tparam T : wrapped type, it should be default constructible.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() = default;
+
+  /** Read the currently active value. Consumer side. */
+  const T& get() const { return buffers_[activeIndex_]; }
+
+  /** Read/write the currently active value. Consumer side. */
+  T& get() { return buffers_[activeIndex_]; }
+
+  /**
+   * Replaces the active value with the most recently published value. Consumer side.
+   * @return True: the active value was updated, False: nothing new has been published.
+   */
+  bool updateFromBuffer() {
+    if ((backState_.load(std::memory_order_relaxed) & newValueFlag) == 0) {
+      return false;
+    }
+    activeIndex_ = backState_.exchange(activeIndex_, std::memory_order_acq_rel) & indexMask;
+    return true;
+  }
+
+  /** Whether a value has been published that is not yet active. */
+  bool hasNewValue() const { return (backState_.load(std::memory_order_relaxed) & newValueFlag) != 0; }
+
+  /**
+   * Gets the buffer to be filled by the producer. It contains an old value, which can be reused or overwritten. Producer side.
+   */
+  T& getWriteBuffer() { return buffers_[writeIndex_]; }
+
+  /** Publishes the write buffer and takes over a new write buffer. Producer side. */
+  void publish() { writeIndex_ = backState_.exchange(writeIndex_ | newValueFlag, std::memory_order_acq_rel) & indexMask; }
+
+  /** Resets all buffers to default constructed values. Must not be called concurrently with any other method. */
+  void reset() {
+    for (auto& buffer : buffers_) {
+      buffer = T();
+    }
+    activeIndex_ = 0;
+    writeIndex_ = 1;
+    backState_.store(2, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr uint8_t indexMask = 0x3;
+  static constexpr uint8_t newValueFlag = 0x4;
+
+  std::array<T, 3> buffers_;
+  uint8_t activeIndex_{0};             // owned by the consumer
+  uint8_t writeIndex_{1};              // owned by the producer
+  std::atomic<uint8_t> backState_{2};  // index of the spare buffer, and whether it holds a new value
+};
+
+}  // namespace ocs2
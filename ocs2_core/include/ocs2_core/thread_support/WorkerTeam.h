@@ -0,0 +1,229 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/SpinBarrier.h>
+
+namespace ocs2 {
+
+/**
+ * A team of persistent worker threads which execute the same task together with the calling thread. In contrast to the ThreadPool,
+ * all team members run concurrently with distinct worker indices, so they can synchronize with each other through barrier() and
+ * allReduce(). Between two tasks, the workers spin for a while before they are parked, such that iterative solvers which dispatch
+ * many short parallel sections do not pay the wake-up latency of a condition variable each time.
+ *
+ * @note run() must not be called concurrently from several threads.
+ */
+class WorkerTeam {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] teamSize: Number of team members including the calling thread. teamSize - 1 worker threads are launched.
+   * @param [in] priority: The worker thread priority
+   * @param [in] cpuAffinity: The CPU cores of the team. The worker thread with index i is pinned to the core cpuAffinity[i % size].
+   *                          The calling thread is not pinned. If empty, the threads are not pinned.
+   * @param [in] spinIterations: The number of spin iterations before a waiting team member is parked.
+   */
+  explicit WorkerTeam(size_t teamSize, int priority = 0, const std::vector<int>& cpuAffinity = {},
+                      size_t spinIterations = SpinBarrier::defaultSpinIterations);
+
+  /**
+   * Destructor
+   */
+  ~WorkerTeam();
+
+  WorkerTeam(const WorkerTeam&) = delete;
+  WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+  /**
+   * Runs the task on all team members concurrently.
+   * - The worker threads run the task with ID in [0, size-2].
+   * - The calling thread runs the task with ID = size-1.
+   *
+   * @note This is a blocking operation, returns when all team members have finished the task. The first exception thrown by any of
+   * the team members is rethrown in the calling thread.
+   * @warning A task which synchronizes through barrier() or allReduce() must not throw in between, since the other team members
+   * would wait for it forever.
+   *
+   * @param [in] taskFunction: task function with signature void(int workerIndex).
+   */
+  template <typename Functor>
+  void run(Functor&& taskFunction);
+
+  /**
+   * Makes numCopies copies of an object, e.g. one problem definition per worker. The copy with index i is made by the team member with
+   * worker index i % size(), such that its memory is allocated and first touched by the thread that uses it. It is therefore local to
+   * the core (and NUMA node) that member is pinned to. The copies are made one after the other, since copying is not required to be
+   * thread-safe.
+   *
+   * @param [in] original: The object to copy.
+   * @param [out] copies: The copies, resized to numCopies.
+   * @param [in] numCopies: The number of copies.
+   */
+  template <typename T>
+  void makeLocalCopies(const T& original, std::vector<T>& copies, size_t numCopies);
+
+  /**
+   * Synchronizes all team members inside a task. See SpinBarrier::arriveAndWait().
+   *
+   * @param [in] completion: Function with signature void() which is called by the last team member to arrive, before the others
+   *                         are released. It must not throw.
+   * @return true for exactly one team member, i.e., the one which called the completion function.
+   */
+  template <typename Completion>
+  bool barrier(Completion&& completion) {
+    return taskBarrier_.arriveAndWait(std::forward<Completion>(completion));
+  }
+  bool barrier() { return taskBarrier_.arriveAndWait(); }
+
+  /**
+   * Reduces a value over all team members inside a task. Every team member has to call this function and receives the same result.
+   * The values are folded in the order of the worker indices, hence the result does not depend on the thread scheduling.
+   *
+   * @param [in] workerIndex: The worker index of the calling team member.
+   * @param [in] value: The contribution of the calling team member.
+   * @param [in] reduction: Binary operation with signature scalar_t(scalar_t, scalar_t).
+   * @return The reduced value.
+   */
+  template <typename BinaryOperation>
+  scalar_t allReduce(int workerIndex, scalar_t value, BinaryOperation reduction);
+
+  /** Get the number of team members including the calling thread. */
+  size_t size() const { return teamSize_; }
+
+ private:
+  using task_body_t = void (*)(void* functorPtr, int workerIndex);
+
+  template <typename Functor>
+  static void invoke(void* functorPtr, int workerIndex) {
+    (*static_cast<Functor*>(functorPtr))(workerIndex);
+  }
+
+  /** Per member storage of allReduce(), padded to a cache line. Double buffered such that consecutive reductions need one barrier. */
+  struct ReductionSlot {
+    scalar_t value[2];
+    size_t count{0};
+    char padding[64 - 2 * sizeof(scalar_t) - sizeof(size_t)];
+  };
+
+  /**
+   * Thread worker loop
+   *
+   * @param [in] workerIndex: worker thread index
+   */
+  void worker(int workerIndex);
+
+  /** Runs the published task and records its exception, if any. */
+  void execute(int workerIndex);
+
+  /** Publishes the task, runs it on the calling thread and waits for the workers. */
+  void dispatch(task_body_t body, void* functorPtr);
+
+  const size_t teamSize_;
+
+  // The current task, written by the calling thread before the start barrier.
+  task_body_t taskBody_{nullptr};
+  void* taskFunctorPtr_{nullptr};
+  bool stop_{false};
+
+  std::atomic_bool failed_{false};
+  std::mutex exceptionLock_;
+  std::exception_ptr exception_;  // protected by exceptionLock_
+
+  SpinBarrier startBarrier_;
+  SpinBarrier finishBarrier_;
+  SpinBarrier taskBarrier_;
+  std::vector<ReductionSlot> reductionSlots_;
+
+  std::vector<std::thread> workerThreads_;
+};
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void WorkerTeam::run(Functor&& taskFunction) {
+  using functor_t = typename std::remove_reference<Functor>::type;
+  if (teamSize_ == 1) {
+    taskFunction(0);
+  } else {
+    dispatch(&invoke<functor_t>, const_cast<void*>(static_cast<const void*>(std::addressof(taskFunction))));
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename T>
+void WorkerTeam::makeLocalCopies(const T& original, std::vector<T>& copies, size_t numCopies) {
+  copies.resize(numCopies);
+  std::mutex copyMutex;
+  run([&](int workerIndex) {
+    std::lock_guard<std::mutex> lock(copyMutex);
+    for (size_t i = workerIndex; i < numCopies; i += teamSize_) {
+      copies[i] = original;
+    }
+  });
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename BinaryOperation>
+scalar_t WorkerTeam::allReduce(int workerIndex, scalar_t value, BinaryOperation reduction) {
+  if (teamSize_ == 1) {
+    return value;
+  }
+
+  auto& ownSlot = reductionSlots_[workerIndex];
+  const size_t buffer = ownSlot.count++ % 2;
+  ownSlot.value[buffer] = value;
+
+  taskBarrier_.arriveAndWait();
+
+  scalar_t result = reductionSlots_.front().value[buffer];
+  for (size_t i = 1; i < teamSize_; ++i) {
+    result = reduction(result, reductionSlots_[i].value[buffer]);
+  }
+  return result;
+}
+
+}  // namespace ocs2
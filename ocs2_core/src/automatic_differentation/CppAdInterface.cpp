@@ -29,10 +29,53 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <regex>
+#include <typeinfo>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/automatic_differentiation/CppAdCompilationScheduler.h>
+#include <ocs2_core/automatic_differentiation/CppAdLibraryCache.h>
+
 namespace ocs2 {
 
+namespace {
+/** Increment when the generated libraries change in a way that is not captured by the library key. */
+constexpr uint64_t libraryKeyVersion = 2;
+
+/** Gives access to the generated sources such that the source generation can be separated from the compilation. */
+class LibrarySourceCollector : public CppAD::cg::ModelLibraryProcessor<scalar_t> {
+ public:
+  explicit LibrarySourceCollector(CppAD::cg::ModelLibraryCSourceGen<scalar_t>& libraryCSourceGen)
+      : CppAD::cg::ModelLibraryProcessor<scalar_t>(libraryCSourceGen) {}
+
+  using CppAD::cg::ModelLibraryProcessor<scalar_t>::getLibrarySources;
+  using CppAD::cg::ModelLibraryProcessor<scalar_t>::getSources;
+};
+
+/**
+ * Converts the generated double precision C source of a model to single precision. The generator writes the base type name wherever
+ * the code declares a value, so declarations, literals and the type check of the info function are all that need to change. The math
+ * functions are made type-generic such that they are evaluated in float as well.
+ */
+std::string toSinglePrecision(const std::string& source) {
+  const std::string doubleInfo = CppAD::cg::ModelCSourceGen<double>::baseTypeName() + "  " + typeid(double).name();
+  const std::string floatInfo = CppAD::cg::ModelCSourceGen<float>::baseTypeName() + "  " + typeid(float).name();
+  std::string result = source;
+  for (auto pos = result.find(doubleInfo); pos != std::string::npos; pos = result.find(doubleInfo, pos + floatInfo.size())) {
+    result.replace(pos, doubleInfo.size(), floatInfo);
+  }
+  result = std::regex_replace(result, std::regex("#include <math.h>"), "#include <tgmath.h>");
+  result = std::regex_replace(result, std::regex("\\bdouble\\b"), "float");
+  // Floating point literals, i.e., with a decimal point or an exponent, that are not part of an identifier
+  const std::regex literal("(^|[^\\w.])((?:\\d+\\.\\d*|\\.\\d+)(?:[eE][+-]?\\d+)?|\\d+[eE][+-]?\\d+)(?![\\w.])");
+  return std::regex_replace(result, literal, "$1$2f");
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -55,163 +98,265 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
     : CppAdInterface([adFunction](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) { adFunction(x, y); }, variableDim, 0,
                      std::move(modelName), std::move(folderName), std::move(compileFlags)){};
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::CppAdInterface(const CppAdPrelinkedModel& prelinkedModel)
+    : variableDim_(prelinkedModel.variableDim), parameterDim_(prelinkedModel.parameterDim), modelName_(prelinkedModel.modelName) {
+  setFolderNames();
+  singlePrecision_ = prelinkedModel.modelNames.count(getSinglePrecisionModelName()) > 0;
+  createModelsFromLibrary(CppAdModelLibrary::load(prelinkedModel));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  rhs.waitForModels();
+  singlePrecision_ = rhs.singlePrecision_;
+  if (rhs.library_ != nullptr) {
+    createModelsFromLibrary(rhs.library_);
+  } else if (isLibraryAvailable()) {
     loadModels(false);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::~CppAdInterface() {
+  // The pending job refers to this object
+  if (modelsFuture_.valid()) {
+    modelsFuture_.wait();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
+  buildModels(approximationOrder, false, verbose);
+}
 
-  // set and declare independent variables and start tape recording
-  ad_vector_t xp(variableDim_ + parameterDim_);
-  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
-  CppAD::Independent(xp);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModels(bool verbose) {
+  loadLibrary(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, verbose);
+}
 
-  // Split in variables and parameters
-  ad_vector_t x = xp.segment(0, variableDim_);
-  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
-  // dependent variable vector
-  ad_vector_t y;
-  // the model equation
-  adFunction_(x, p, y);
-  rangeDim_ = y.rows();
-  // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
-  // Optimize the operation sequence
-  fun.optimize();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
+  buildModels(approximationOrder, true, verbose);
+}
 
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModelsAsync(ApproximationOrder approximationOrder, bool verbose) {
+  submitModelSources(approximationOrder, false, verbose);
+}
 
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailableAsync(ApproximationOrder approximationOrder, bool verbose) {
+  submitModelSources(approximationOrder, true, verbose);
+}
 
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
-  }
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::submitModelSources(ApproximationOrder approximationOrder, bool useCache, bool verbose) {
+  waitForModels();
+  // The tape is recorded before returning, such that the model function and whatever it refers to are not used by the job.
+  auto modelSourcesPtr = std::make_shared<const ModelSources>(recordModelSources(approximationOrder, useCache));
+  modelsFuture_ = CppAdCompilationScheduler::instance().submit([this, modelSourcesPtr, approximationOrder, verbose]() {
+    compileModelSources(*modelSourcesPtr, approximationOrder, verbose);
+  });
+}
 
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::waitForModels() const {
+  if (modelsFuture_.valid()) {
+    modelsFuture_.get();
+  }
+}
 
-  setSparsityNonzeros();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::waitForModels(const std::vector<const CppAdInterface*>& interfaces) {
+  std::vector<std::shared_future<void>> futures;
+  futures.reserve(interfaces.size());
+  for (const auto* interfacePtr : interfaces) {
+    if (interfacePtr->modelsFuture_.valid()) {
+      futures.push_back(interfacePtr->modelsFuture_);
+    }
+  }
 
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  if (CppAdDeferredWait::current_ != nullptr) {
+    auto& deferredFutures = CppAdDeferredWait::current_->futures_;
+    deferredFutures.insert(deferredFutures.end(), futures.begin(), futures.end());
+  } else {
+    waitForAll(futures);
   }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::loadModels(bool verbose) {
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
-              << std::endl;
+void CppAdInterface::waitForAll(const std::vector<std::shared_future<void>>& futures) {
+  std::exception_ptr firstException;
+  for (const auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!firstException) {
+        firstException = std::current_exception();
+      }
+    }
   }
-  dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
-  model_ = dynamicLib_->model(modelName_);
-  rangeDim_ = model_->Range();
+  if (firstException) {
+    std::rethrow_exception(firstException);
+  }
+}
 
-  setSparsityNonzeros();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+thread_local CppAdDeferredWait* CppAdDeferredWait::current_ = nullptr;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdDeferredWait::CppAdDeferredWait() : previous_(current_) {
+  current_ = this;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
-    loadModels(verbose);
-  } else {
-    createModels(approximationOrder, verbose);
+CppAdDeferredWait::~CppAdDeferredWait() {
+  current_ = previous_;
+  // The models may only be used once their jobs are done. Exceptions cannot be reported here, call waitAll() to get them.
+  for (const auto& future : futures_) {
+    future.wait();
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdDeferredWait::waitAll() {
+  std::vector<std::shared_future<void>> futures;
+  futures.swap(futures_);
+  CppAdInterface::waitForAll(futures);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
+  vector_t functionValue;
+  getFunctionValue(x, p, functionValue);
+  return functionValue;
+}
 
-  vector_t functionValue(model_->Range());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p, vector_t& value) const {
+  const auto xp = setInputBuffer(x, p);
+  value.resize(rangeDim_);
 
-  model_->ForwardZero(xp, functionValue);
-  assert(functionValue.allFinite());
-  return functionValue;
+  if (singlePrecisionModel_ != nullptr) {
+    getSinglePrecisionFunctionValue(xp, value);
+  } else {
+    model_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                        CppAD::cg::ArrayView<scalar_t>(value.data(), value.size()));
+  }
+  assert(value.allFinite());
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t jacobian;
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const {
+  getSparseJacobian(x, p, jacobianBuffer_);
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
-    jacobian(rows[i], cols[i]) = sparseJacobian[i];
+  const auto& indices = getJacobianNonzeroIndices();
+  jacobian.setZero(rangeDim_, variableDim_);
+  for (size_t i = 0; i < indices.size(); i++) {
+    jacobian(indices.rows[i], indices.cols[i]) = jacobianBuffer_[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+void CppAdInterface::getSparseJacobian(const vector_t& x, const vector_t& p, vector_t& nonzeros) const {
+  const auto xp = setInputBuffer(x, p);
+  nonzeros.resize(getJacobianNonzeroIndices().size());
 
+  if (singlePrecisionModel_ != nullptr) {
+    getSinglePrecisionSparseJacobian(xp, nonzeros);
+  } else {
+    size_t const* rows;
+    size_t const* cols;
+    // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+    model_->SparseJacobian(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                           CppAD::cg::ArrayView<scalar_t>(nonzeros.data(), nonzeros.size()), &rows, &cols);
+  }
+
+  assert(nonzeros.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
   ScalarFunctionQuadraticApproximation gnApprox;
+  getGaussNewtonApproximation(x, p, gnApprox);
+  return gnApprox;
+}
 
-  // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p,
+                                                 ScalarFunctionQuadraticApproximation& gnApprox) const {
+  // Value and Jacobian
+  getValueAndSparseJacobian(x, p, valueBuffer_, jacobianBuffer_);
+  const vector_t& valueVector = valueBuffer_;
+  const vector_t& sparseJacobian = jacobianBuffer_;
   gnApprox.f = 0.5 * valueVector.squaredNorm();
-
-  // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  const auto& indices = getJacobianNonzeroIndices();
+  const auto& rows = indices.rows;
+  const auto& cols = indices.cols;
+  const size_t nnzJacobian = indices.size();
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
+  for (size_t i = 0; i < nnzJacobian; i++) {
     gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
   }
 
@@ -222,25 +367,22 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
    * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
    */
   gnApprox.dfdxx.setZero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; ++i) {
+  for (size_t i = 0; i < nnzJacobian; ++i) {
     const size_t row_i = rows[i];
     const size_t col_i = cols[i];
     const scalar_t v_i = sparseJacobian[i];
     // Diagonal element always exists:
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
+    for (size_t j = i + 1; j < nnzJacobian && rows[j] == row_i; ++j) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
     }
   }
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
-  return gnApprox;
 }
 
 /******************************************************************************************************/
@@ -257,25 +399,14 @@ matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
-
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
-  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
-  size_t const* rows;
-  size_t const* cols;
-
-  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
-
-  // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+  vector_t sparseHessian;
+  getSparseHessian(w, x, p, sparseHessian);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
+  const auto& indices = getHessianNonzeroIndices();
   matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzHessian_; i++) {
-    hessian(rows[i], cols[i]) = sparseHessian[i];
+  for (size_t i = 0; i < indices.size(); i++) {
+    hessian(indices.rows[i], indices.cols[i]) = sparseHessian[i];
   }
 
   // Copy upper triangular to lower triangular part
@@ -285,6 +416,502 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   return hessian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& nonzeros) const {
+  const auto xp = setInputBuffer(x, p);
+  nonzeros.resize(getHessianNonzeroIndices().size());
+
+  size_t const* rows;
+  size_t const* cols;
+  // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+  model_->SparseHessian(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                        CppAD::cg::ArrayView<const scalar_t>(w.data(), w.size()),
+                        CppAD::cg::ArrayView<scalar_t>(nonzeros.data(), nonzeros.size()), &rows, &cols);
+
+  assert(nonzeros.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getValueAndSparseJacobian(const vector_t& x, const vector_t& p, vector_t& value, vector_t& jacobianNonzeros) const {
+  const size_t nnzJacobian = getJacobianNonzeroIndices().size();
+  // The fused model is only generated in double precision
+  if (singlePrecisionModel_ != nullptr || fusedModel_ == nullptr || fusedModel_->Domain() != variableDim_ + parameterDim_) {
+    getFunctionValue(x, p, value);
+    getSparseJacobian(x, p, jacobianNonzeros);
+    return;
+  }
+
+  const auto xp = setInputBuffer(x, p);
+  fusedModel_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                           CppAD::cg::ArrayView<scalar_t>(fusedBuffer_.data(), fusedModel_->Range()));
+
+  value = fusedBuffer_.head(rangeDim_);
+  jacobianNonzeros = fusedBuffer_.segment(rangeDim_, nnzJacobian);
+  assert(fusedBuffer_.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getValueAndSparseDerivatives(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& value,
+                                                  vector_t& jacobianNonzeros, vector_t& hessianNonzeros) const {
+  const size_t nnzJacobian = getJacobianNonzeroIndices().size();
+  const size_t nnzHessian = getHessianNonzeroIndices().size();
+  if (fusedHessianModel_ == nullptr || fusedHessianModel_->Domain() != variableDim_ + parameterDim_ + rangeDim_) {
+    getFunctionValue(x, p, value);
+    getSparseJacobian(x, p, jacobianNonzeros);
+    getSparseHessian(w, x, p, hessianNonzeros);
+    return;
+  }
+
+  inputBuffer_ << x, p, w;
+  fusedHessianModel_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(inputBuffer_.data(), inputBuffer_.size()),
+                                  CppAD::cg::ArrayView<scalar_t>(fusedBuffer_.data(), fusedHessianModel_->Range()));
+
+  value = fusedBuffer_.head(rangeDim_);
+  jacobianNonzeros = fusedBuffer_.segment(rangeDim_, nnzJacobian);
+  hessianNonzeros = fusedBuffer_.segment(rangeDim_ + nnzJacobian, nnzHessian);
+  assert(fusedBuffer_.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValues(const matrix_t& x, const matrix_t& p, matrix_t& values) const {
+  checkBatchDimensions(x, p);
+  const size_t numPoints = x.cols();
+  values.resize(rangeDim_, numPoints);
+
+  const vector_t noParameters;
+  for (size_t i = 0; i < numPoints; i++) {
+    const auto xp = (parameterDim_ > 0) ? setInputBuffer(x.col(i), p.col(i)) : setInputBuffer(x.col(i), noParameters);
+    if (singlePrecisionModel_ != nullptr) {
+      getSinglePrecisionFunctionValue(xp, values.col(i));
+    } else {
+      model_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                          CppAD::cg::ArrayView<scalar_t>(values.col(i).data(), values.rows()));
+    }
+  }
+
+  assert(values.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseJacobians(const matrix_t& x, const matrix_t& p, matrix_t& nonzeros) const {
+  checkBatchDimensions(x, p);
+  const size_t numPoints = x.cols();
+  nonzeros.resize(getJacobianNonzeroIndices().size(), numPoints);
+
+  const vector_t noParameters;
+  size_t const* rows;
+  size_t const* cols;
+  for (size_t i = 0; i < numPoints; i++) {
+    const auto xp = (parameterDim_ > 0) ? setInputBuffer(x.col(i), p.col(i)) : setInputBuffer(x.col(i), noParameters);
+    if (singlePrecisionModel_ != nullptr) {
+      getSinglePrecisionSparseJacobian(xp, nonzeros.col(i));
+    } else {
+      model_->SparseJacobian(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                             CppAD::cg::ArrayView<scalar_t>(nonzeros.col(i).data(), nonzeros.rows()), &rows, &cols);
+    }
+  }
+
+  assert(nonzeros.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Eigen::Ref<const vector_t> CppAdInterface::setInputBuffer(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p) const {
+  inputBuffer_.head(variableDim_) = x;
+  inputBuffer_.segment(variableDim_, parameterDim_) = p;
+  return inputBuffer_.head(variableDim_ + parameterDim_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSinglePrecisionFunctionValue(const Eigen::Ref<const vector_t>& xp, Eigen::Ref<vector_t> value) const {
+  auto xpSinglePrecision = singlePrecisionInputBuffer_.head(xp.size());
+  auto valueSinglePrecision = singlePrecisionOutputBuffer_.head(value.size());
+  xpSinglePrecision = xp.cast<float>();
+  singlePrecisionModel_->ForwardZero(CppAD::cg::ArrayView<const float>(xpSinglePrecision.data(), xpSinglePrecision.size()),
+                                     CppAD::cg::ArrayView<float>(valueSinglePrecision.data(), valueSinglePrecision.size()));
+  value = valueSinglePrecision.cast<scalar_t>();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSinglePrecisionSparseJacobian(const Eigen::Ref<const vector_t>& xp, Eigen::Ref<vector_t> nonzeros) const {
+  auto xpSinglePrecision = singlePrecisionInputBuffer_.head(xp.size());
+  auto nonzerosSinglePrecision = singlePrecisionOutputBuffer_.head(nonzeros.size());
+  xpSinglePrecision = xp.cast<float>();
+  size_t const* rows;
+  size_t const* cols;
+  singlePrecisionModel_->SparseJacobian(CppAD::cg::ArrayView<const float>(xpSinglePrecision.data(), xpSinglePrecision.size()),
+                                        CppAD::cg::ArrayView<float>(nonzerosSinglePrecision.data(), nonzerosSinglePrecision.size()), &rows,
+                                        &cols);
+  nonzeros = nonzerosSinglePrecision.cast<scalar_t>();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::buildModels(ApproximationOrder approximationOrder, bool useCache, bool verbose) {
+  compileModelSources(recordModelSources(approximationOrder, useCache), approximationOrder, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::ModelSources CppAdInterface::recordModelSources(ApproximationOrder approximationOrder, bool useCache) {
+  createFolderStructure();
+
+  // CppAD tapes are not thread-safe, only the compilation runs concurrently with other models
+  ModelSources modelSources;
+  std::lock_guard<std::mutex> lock(CppAdCompilationScheduler::tapingMutex());
+  auto funPtr = recordTape();
+  modelSources.key = getLibraryKey(*funPtr, approximationOrder);
+  if (useCache) {
+    modelSources.cachedLibraryFile = findCachedLibrary(modelSources.key);
+  }
+  if (modelSources.cachedLibraryFile.empty()) {
+    modelSources.sources = generateSources(approximationOrder, *funPtr, true);
+  }
+  return modelSources;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileModelSources(const ModelSources& modelSources, ApproximationOrder approximationOrder, bool verbose) {
+  const auto& key = modelSources.key;
+  const auto& cachedLibraryFile = modelSources.cachedLibraryFile;
+  const auto& sources = modelSources.sources;
+
+  if (!cachedLibraryFile.empty()) {
+    loadLibrary(cachedLibraryFile, verbose);
+    return;
+  }
+
+  // Compile to temporary shared library file to avoid interference between processes
+  const std::string libraryFileName = modelName_ + "_lib_" + key + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  const std::string libraryFile = libraryFolder_ + "/" + libraryFileName;
+  const std::string tmpLibraryFile = libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  setCompilerOptions(gccCompiler);
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiling Shared Library: " << tmpLibraryFile << std::endl;
+  }
+
+  try {
+    gccCompiler.compileSources(sources, true);
+    gccCompiler.buildDynamic(tmpLibraryFile);
+  } catch (...) {
+    gccCompiler.cleanup();
+    throw;
+  }
+  gccCompiler.cleanup();
+
+  // Publish the library under its key. Concurrent writers of the same key produce equivalent libraries and the rename is atomic.
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Renaming " << tmpLibraryFile << " to " << libraryFile << std::endl;
+  }
+  boost::filesystem::rename(tmpLibraryFile, libraryFile);
+  cppad_library_cache::addLibrary(getIndexFile(), key, libraryFileName, getLibraryDescription(approximationOrder));
+
+  // Point the unkeyed library name used by loadModels() to the latest library
+  const std::string tmpLink = libraryName_ + tmpName_ + ".link";
+  boost::filesystem::create_symlink(libraryFileName, tmpLink);
+  boost::filesystem::rename(tmpLink, libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+
+  loadLibrary(libraryFile, false);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::generatePrelinkedModel(ApproximationOrder approximationOrder, const std::string& outputFolder, bool verbose) {
+  CppAdPrelinkedModel prelinkedModel{modelName_, variableDim_, parameterDim_, {modelName_}, {}};
+  std::map<std::string, std::string> sources;
+  {
+    std::lock_guard<std::mutex> lock(CppAdCompilationScheduler::tapingMutex());
+    auto funPtr = recordTape();
+    // The library functions are only needed to load a shared library, the prelinked models are looked up in the function table.
+    sources = generateSources(approximationOrder, *funPtr, false);
+  }
+  if (approximationOrder != ApproximationOrder::Zero) {
+    prelinkedModel.modelNames.insert(getFusedModelName());
+  }
+  if (approximationOrder == ApproximationOrder::Second) {
+    prelinkedModel.modelNames.insert(getFusedHessianModelName());
+  }
+  if (singlePrecision_) {
+    prelinkedModel.modelNames.insert(getSinglePrecisionModelName());
+  }
+
+  std::vector<std::string> functionNames;
+  for (const auto& name : prelinkedModel.modelNames) {
+    const auto modelFunctions = cppad_prelinked::findModelFunctions(name, sources);
+    functionNames.insert(functionNames.end(), modelFunctions.begin(), modelFunctions.end());
+  }
+
+  boost::filesystem::create_directories(outputFolder);
+  const std::string libraryFile = outputFolder + "/lib" + modelName_ + "_prelinked.a";
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  if (!compileFlags_.empty()) {
+    gccCompiler.setCompileFlags(compileFlags_);
+  }
+  gccCompiler.setTemporaryFolder(outputFolder + "/" + tmpName_);
+  gccCompiler.setSourcesFolder(outputFolder + "/sources");
+  gccCompiler.setSaveToDiskFirst(true);
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiling Static Library: " << libraryFile << std::endl;
+  }
+
+  try {
+    // Position independent, such that the library can be linked into shared libraries
+    gccCompiler.compileSources(sources, true);
+    // Archive from scratch, ar would keep the objects of a previous model otherwise
+    boost::filesystem::remove(libraryFile);
+    CppAD::cg::ArArchiver archiver;
+    archiver.create(libraryFile, gccCompiler.getObjectFiles());
+  } catch (...) {
+    gccCompiler.cleanup();
+    throw;
+  }
+  gccCompiler.cleanup();
+
+  cppad_prelinked::writeFunctionTable(outputFolder, prelinkedModel, functionNames);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadLibrary(const std::string& libraryFile, bool verbose) {
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryFile << std::endl;
+  }
+  createModelsFromLibrary(CppAdModelLibrary::load(libraryFile, modelName_));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModelsFromLibrary(std::shared_ptr<const CppAdModelLibrary> library) {
+  // Release the models of the previous library first
+  model_.reset();
+  fusedModel_.reset();
+  fusedHessianModel_.reset();
+  singlePrecisionModel_.reset();
+  library_ = std::move(library);
+
+  model_ = library_->createModel(modelName_);
+  fusedModel_ = library_->createModel(getFusedModelName());
+  fusedHessianModel_ = library_->createModel(getFusedHessianModelName());
+  if (singlePrecision_) {
+    singlePrecisionModel_ = library_->createSinglePrecisionModel(getSinglePrecisionModelName());
+  }
+  rangeDim_ = model_->Range();
+
+  // Size the scratch buffers once, such that the evaluations do not allocate
+  const size_t nnzJacobian = getJacobianNonzeroIndices().size();
+  inputBuffer_.setZero(variableDim_ + parameterDim_ + rangeDim_);
+  valueBuffer_.setZero(rangeDim_);
+  jacobianBuffer_.setZero(nnzJacobian);
+  fusedBuffer_.setZero(std::max((fusedModel_ != nullptr) ? fusedModel_->Range() : 0,
+                                 (fusedHessianModel_ != nullptr) ? fusedHessianModel_->Range() : 0));
+  singlePrecisionInputBuffer_.setZero((singlePrecisionModel_ != nullptr) ? variableDim_ + parameterDim_ : 0);
+  singlePrecisionOutputBuffer_.setZero((singlePrecisionModel_ != nullptr) ? std::max(rangeDim_, nnzJacobian) : 0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ad_fun_t> CppAdInterface::recordTape() {
+  // set and declare independent variables and start tape recording
+  ad_vector_t xp(variableDim_ + parameterDim_);
+  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xp);
+
+  // Split in variables and parameters
+  ad_vector_t x = xp.segment(0, variableDim_);
+  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
+  // dependent variable vector
+  ad_vector_t y;
+  // the model equation
+  adFunction_(x, p, y);
+  rangeDim_ = y.rows();
+  // create f: xp -> y and stop tape recording
+  std::unique_ptr<ad_fun_t> funPtr(new ad_fun_t(xp, y));
+  // Optimize the operation sequence
+  funPtr->optimize();
+  return funPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::map<std::string, std::string> CppAdInterface::generateSources(ApproximationOrder approximationOrder, ad_fun_t& fun,
+                                                                   bool withLibrarySources) const {
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
+  setApproximationOrder(approximationOrder, sourceGen, fun);
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
+  std::vector<CppAD::cg::ModelCSourceGen<scalar_t>*> sourceGens{&sourceGen};
+
+  // The fused models only provide the zero order forward sweep of the fused functions. Second order libraries have both, such that
+  // getValueAndSparseJacobian() does not evaluate the Hessian.
+  std::unique_ptr<ad_fun_t> fusedFunPtr;
+  std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> fusedSourceGen;
+  if (approximationOrder != ApproximationOrder::Zero) {
+    fusedFunPtr = recordFusedTape(ApproximationOrder::First, fun);
+    fusedSourceGen.reset(new CppAD::cg::ModelCSourceGen<scalar_t>(*fusedFunPtr, getFusedModelName()));
+    libraryCSourceGen.addModel(*fusedSourceGen);
+    sourceGens.push_back(fusedSourceGen.get());
+  }
+  std::unique_ptr<ad_fun_t> fusedHessianFunPtr;
+  std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> fusedHessianSourceGen;
+  if (approximationOrder == ApproximationOrder::Second) {
+    fusedHessianFunPtr = recordFusedTape(ApproximationOrder::Second, fun);
+    fusedHessianSourceGen.reset(new CppAD::cg::ModelCSourceGen<scalar_t>(*fusedHessianFunPtr, getFusedHessianModelName()));
+    libraryCSourceGen.addModel(*fusedHessianSourceGen);
+    sourceGens.push_back(fusedHessianSourceGen.get());
+  }
+
+  // The single precision model is generated as a double precision model and converted afterwards
+  std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> singlePrecisionSourceGen;
+  if (singlePrecision_) {
+    singlePrecisionSourceGen.reset(new CppAD::cg::ModelCSourceGen<scalar_t>(fun, getSinglePrecisionModelName()));
+    setApproximationOrder(std::min(approximationOrder, ApproximationOrder::First), *singlePrecisionSourceGen, fun);
+    libraryCSourceGen.addModel(*singlePrecisionSourceGen);
+  }
+
+  LibrarySourceCollector collector(libraryCSourceGen);
+  std::map<std::string, std::string> sources;
+  for (auto* modelSourceGen : sourceGens) {
+    const auto& modelSources = collector.getSources(*modelSourceGen);
+    sources.insert(modelSources.begin(), modelSources.end());
+  }
+  if (singlePrecisionSourceGen != nullptr) {
+    for (const auto& source : collector.getSources(*singlePrecisionSourceGen)) {
+      sources[source.first] = toSinglePrecision(source.second);
+    }
+  }
+  if (withLibrarySources) {
+    const auto& librarySources = collector.getLibrarySources();
+    sources.insert(librarySources.begin(), librarySources.end());
+  }
+  return sources;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ad_fun_t> CppAdInterface::recordFusedTape(ApproximationOrder approximationOrder, ad_fun_t& fun) const {
+  const size_t domainDim = variableDim_ + parameterDim_;
+  const size_t weightDim = (approximationOrder == ApproximationOrder::Second) ? rangeDim_ : 0;
+
+  // Same nonzeros in the same order as the sparse derivatives of the model
+  const auto jacobianIndices = cppad_sparsity::getNonzeroIndices(createJacobianSparsity(fun));
+  const auto hessianIndices = (approximationOrder == ApproximationOrder::Second)
+                                  ? cppad_sparsity::getNonzeroIndices(createHessianSparsity(fun))
+                                  : cppad_sparsity::NonzeroIndices();
+
+  // The derivatives of the model are taped as functions of (x, p, w)
+  auto adFun = fun.base2ad();
+  ad_vector_t xpw(domainDim + weightDim);
+  xpw.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xpw);
+  const std::vector<ad_scalar_t> xp(xpw.data(), xpw.data() + domainDim);
+  const std::vector<ad_scalar_t> w(xpw.data() + domainDim, xpw.data() + domainDim + weightDim);
+
+  const std::vector<ad_scalar_t> y = adFun.Forward(0, xp);
+
+  std::vector<ad_scalar_t> jacobian(jacobianIndices.size());
+  if (!jacobian.empty()) {
+    CppAD::sparse_jacobian_work jacobianWork;
+    if (variableDim_ <= rangeDim_) {
+      adFun.SparseJacobianForward(xp, cppad_sparsity::getJacobianSparsityPattern(fun), jacobianIndices.rows, jacobianIndices.cols, jacobian,
+                                  jacobianWork);
+    } else {
+      adFun.SparseJacobianReverse(xp, cppad_sparsity::getJacobianSparsityPattern(fun), jacobianIndices.rows, jacobianIndices.cols, jacobian,
+                                  jacobianWork);
+    }
+  }
+
+  std::vector<ad_scalar_t> hessian(hessianIndices.size());
+  if (!hessian.empty()) {
+    CppAD::sparse_hessian_work hessianWork;
+    adFun.SparseHessian(xp, w, cppad_sparsity::getHessianSparsityPattern(fun), hessianIndices.rows, hessianIndices.cols, hessian,
+                        hessianWork);
+  }
+
+  ad_vector_t fused(y.size() + jacobian.size() + hessian.size());
+  std::copy(y.begin(), y.end(), fused.data());
+  std::copy(jacobian.begin(), jacobian.end(), fused.data() + y.size());
+  std::copy(hessian.begin(), hessian.end(), fused.data() + y.size() + jacobian.size());
+
+  std::unique_ptr<ad_fun_t> fusedFunPtr(new ad_fun_t(xpw, fused));
+  fusedFunPtr->optimize();
+  return fusedFunPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getLibraryKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const {
+  cppad_library_cache::Hash hash;
+  hash.add(libraryKeyVersion).add(modelName_);
+  hash.add(variableDim_).add(parameterDim_).add(rangeDim_).add(static_cast<uint64_t>(approximationOrder));
+  hash.add(static_cast<uint64_t>(singlePrecision_));
+  hash.add(compileFlags_.size());
+  for (const auto& flag : compileFlags_) {
+    hash.add(flag);
+  }
+  hash.add(cppad_library_cache::getOperationGraph(fun));
+  return hash.toString();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::findCachedLibrary(const std::string& key) const {
+  const std::string libraryFileName = cppad_library_cache::findLibrary(getIndexFile(), key);
+  if (libraryFileName.empty() || !boost::filesystem::exists(libraryFolder_ + "/" + libraryFileName)) {
+    return "";
+  }
+  return libraryFolder_ + "/" + libraryFileName;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getLibraryDescription(ApproximationOrder approximationOrder) const {
+  std::string description = "variableDim=" + std::to_string(variableDim_) + " parameterDim=" + std::to_string(parameterDim_) +
+                            " rangeDim=" + std::to_string(rangeDim_) +
+                            " approximationOrder=" + std::to_string(static_cast<int>(approximationOrder)) +
+                            " singlePrecision=" + std::to_string(static_cast<int>(singlePrecision_)) + " compileFlags=";
+  for (const auto& flag : compileFlags_) {
+    description += flag + " ";
+  }
+  return description;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getIndexFile() const {
+  return libraryName_ + "_index";
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -318,9 +945,9 @@ void CppAdInterface::createFolderStructure() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::string CppAdInterface::getUniqueTemporaryName() const {
-  // Random string should be unique for each process and time of calling.
-  int randomFromClock = std::chrono::high_resolution_clock::now().time_since_epoch().count() % 1000;
-  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid());
+  // Unique for each process and each interface of the process, the compilation jobs of several interfaces run concurrently.
+  static std::atomic<size_t> counter{0};
+  return std::string("cppadcg_tmp") + std::to_string(getpid()) + "_" + std::to_string(counter++);
 }
 
 /******************************************************************************************************/
@@ -342,6 +969,20 @@ void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compil
   compiler.setSaveToDiskFirst(true);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::checkBatchDimensions(const matrix_t& x, const matrix_t& p) const {
+  if (static_cast<size_t>(x.rows()) != variableDim_) {
+    throw std::runtime_error("[CppAdInterface] The inputs of " + modelName_ + " have " + std::to_string(x.rows()) + " rows instead of " +
+                             std::to_string(variableDim_));
+  }
+  if (parameterDim_ > 0 && (static_cast<size_t>(p.rows()) != parameterDim_ || p.cols() != x.cols())) {
+    throw std::runtime_error("[CppAdInterface] The parameters of " + modelName_ + " must be a " + std::to_string(parameterDim_) + " x " +
+                             std::to_string(x.cols()) + " matrix");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -363,18 +1004,6 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
   }
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void CppAdInterface::setSparsityNonzeros() {
-  if (model_->isJacobianSparsityAvailable()) {
-    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
-  }
-  if (model_->isHessianSparsityAvailable()) {
-    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
-  }
-}
-
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,192 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdLibraryCache.h>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace cppad_library_cache {
+
+namespace {
+/** Holds an exclusive flock on a lock file next to the index for the lifetime of the object. */
+class IndexLock {
+ public:
+  explicit IndexLock(const std::string& indexFile) : fileDescriptor_(::open((indexFile + ".lock").c_str(), O_RDWR | O_CREAT, 0644)) {
+    if (fileDescriptor_ < 0 || ::flock(fileDescriptor_, LOCK_EX) != 0) {
+      if (fileDescriptor_ >= 0) {
+        ::close(fileDescriptor_);
+      }
+      throw std::runtime_error("[cppad_library_cache] Could not lock the index " + indexFile);
+    }
+  }
+  ~IndexLock() {
+    ::flock(fileDescriptor_, LOCK_UN);
+    ::close(fileDescriptor_);
+  }
+  IndexLock(const IndexLock&) = delete;
+  IndexLock& operator=(const IndexLock&) = delete;
+
+ private:
+  int fileDescriptor_;
+};
+
+/** An index entry is a line "key<TAB>libraryFile<TAB>description". Returns false for malformed lines. */
+bool parseEntry(const std::string& line, std::string& key, std::string& libraryFile) {
+  const auto first = line.find('\t');
+  if (first == std::string::npos) {
+    return false;
+  }
+  const auto second = line.find('\t', first + 1);
+  key = line.substr(0, first);
+  libraryFile = line.substr(first + 1, second == std::string::npos ? std::string::npos : second - first - 1);
+  return !key.empty() && !libraryFile.empty();
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Hash& Hash::add(const std::string& data) {
+  add(static_cast<uint64_t>(data.size()));
+  addBytes(data.data(), data.size());
+  return *this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Hash& Hash::add(uint64_t value) {
+  char bytes[sizeof(uint64_t)];
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFFU);
+  }
+  addBytes(bytes, sizeof(uint64_t));
+  return *this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string Hash::toString() const {
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << value_;
+  return stream.str();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Hash::addBytes(const char* data, size_t size) {
+  constexpr uint64_t fnvPrime = 1099511628211ULL;
+  for (size_t i = 0; i < size; ++i) {
+    value_ ^= static_cast<uint8_t>(data[i]);
+    value_ *= fnvPrime;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string getOperationGraph(CppAD::ADFun<ad_base_t>& fun) {
+  CppAD::cg::CodeHandler<scalar_t> handler;
+  std::vector<ad_base_t> independentVariables(fun.Domain());
+  handler.makeVariables(independentVariables);
+  std::vector<ad_base_t> dependentVariables = fun.Forward(0, independentVariables);
+
+  // Print all digits of the constants such that models differing only in a parameter value get different hashes.
+  CppAD::cg::LanguageC<scalar_t> langC("double");
+  langC.setParameterPrecision(std::numeric_limits<scalar_t>::max_digits10);
+  CppAD::cg::LangCDefaultVariableNameGenerator<scalar_t> nameGen;
+
+  std::ostringstream code;
+  handler.generateCode(code, langC, dependentVariables, nameGen);
+  return code.str();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string findLibrary(const std::string& indexFile, const std::string& key) {
+  // The index is replaced atomically, no lock is needed for reading.
+  std::ifstream index(indexFile);
+  std::string line, entryKey, entryLibraryFile;
+  while (std::getline(index, line)) {
+    if (parseEntry(line, entryKey, entryLibraryFile) && entryKey == key) {
+      return entryLibraryFile;
+    }
+  }
+  return "";
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addLibrary(const std::string& indexFile, const std::string& key, const std::string& libraryFile, const std::string& description) {
+  IndexLock lock(indexFile);
+
+  // Copy the other entries
+  std::ostringstream entries;
+  {
+    std::ifstream index(indexFile);
+    std::string line, entryKey, entryLibraryFile;
+    while (std::getline(index, line)) {
+      if (parseEntry(line, entryKey, entryLibraryFile) && entryKey != key) {
+        entries << line << '\n';
+      }
+    }
+  }
+  entries << key << '\t' << libraryFile << '\t' << description << '\n';
+
+  // Write to a temporary file and atomically replace the index
+  const std::string tmpIndexFile = indexFile + ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream tmpIndex(tmpIndexFile, std::ios::trunc);
+    tmpIndex << entries.str();
+    if (!tmpIndex.flush()) {
+      throw std::runtime_error("[cppad_library_cache::addLibrary] Could not write " + tmpIndexFile);
+    }
+  }
+  if (std::rename(tmpIndexFile.c_str(), indexFile.c_str()) != 0) {
+    std::remove(tmpIndexFile.c_str());
+    throw std::runtime_error("[cppad_library_cache::addLibrary] Could not replace " + indexFile);
+  }
+}
+
+}  // namespace cppad_library_cache
+}  // namespace ocs2
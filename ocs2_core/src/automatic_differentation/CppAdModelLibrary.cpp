@@ -0,0 +1,210 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdModelLibrary.h>
+
+#include <map>
+
+#include <boost/filesystem.hpp>
+
+namespace ocs2 {
+
+namespace {
+/**
+ * A model whose functions are looked up by a function loader instead of by the model classes of the dynamic library. Used for the
+ * prelinked libraries, and for the single precision models, which cannot be created by a double precision dynamic library.
+ */
+template <typename Base>
+class LoadedFunctionModel : public CppAD::cg::FunctorGenericModel<Base> {
+ public:
+  using function_loader_t = std::function<void*(const std::string&, bool)>;
+
+  LoadedFunctionModel(const std::string& modelName, function_loader_t functionLoader)
+      : CppAD::cg::FunctorGenericModel<Base>(modelName), functionLoader_(std::move(functionLoader)) {
+    this->init();
+  }
+
+ protected:
+  void* loadFunction(const std::string& functionName, bool required) override { return functionLoader_(functionName, required); }
+
+ private:
+  function_loader_t functionLoader_;
+};
+
+/** Returns the function loader of a prelinked model. */
+std::function<void*(const std::string&, bool)> getFunctionLoader(const CppAdPrelinkedModel& prelinkedModel) {
+  const auto* functions = &prelinkedModel.functions;
+  const std::string modelName = prelinkedModel.modelName;
+  return [functions, modelName](const std::string& functionName, bool required) -> void* {
+    const auto it = functions->find(functionName);
+    if (it == functions->end()) {
+      if (required) {
+        throw std::runtime_error("[CppAdModelLibrary] The prelinked library of " + modelName + " has no function " + functionName);
+      }
+      return nullptr;
+    }
+    return it->second;
+  };
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelLibrary::ModelDeleter::operator()(CppAD::cg::GenericModel<scalar_t>* model) const {
+  std::lock_guard<std::mutex> lock(library->modelMutex_);
+  delete model;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelLibrary::ModelDeleter::operator()(CppAD::cg::GenericModel<float>* model) const {
+  std::lock_guard<std::mutex> lock(library->modelMutex_);
+  delete model;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const CppAdModelLibrary> CppAdModelLibrary::load(const std::string& libraryFile, const std::string& modelName) {
+  // The sparsity depends on the model, a library file may contain several models.
+  const std::string key = boost::filesystem::canonical(libraryFile).string() + ":" + modelName;
+  return getShared(key, [&]() { return new CppAdModelLibrary(libraryFile, modelName); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const CppAdModelLibrary> CppAdModelLibrary::load(const CppAdPrelinkedModel& prelinkedModel) {
+  // The generated functions are global symbols, hence the model name identifies the prelinked library.
+  const std::string key = "prelinked:" + prelinkedModel.modelName;
+  return getShared(key, [&]() { return new CppAdModelLibrary(prelinkedModel); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const CppAdModelLibrary> CppAdModelLibrary::getShared(const std::string& key,
+                                                                      const std::function<CppAdModelLibrary*()>& create) {
+  static std::mutex registryMutex;
+  static std::map<std::string, std::weak_ptr<const CppAdModelLibrary>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto libraryPtr = registry[key].lock();
+  if (libraryPtr == nullptr) {
+    libraryPtr.reset(create());
+    registry[key] = libraryPtr;
+
+    // Drop the entries of closed libraries
+    for (auto it = registry.begin(); it != registry.end();) {
+      it = it->second.expired() ? registry.erase(it) : std::next(it);
+    }
+  }
+  return libraryPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelLibrary::CppAdModelLibrary(const std::string& libraryFile, const std::string& modelName)
+    : libraryFile_(libraryFile), dynamicLib_(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryFile)) {
+  const auto model = dynamicLib_->model(modelName);
+  if (model == nullptr) {
+    throw std::runtime_error("[CppAdModelLibrary] The library " + libraryFile + " does not contain the model " + modelName);
+  }
+  setSparsity(*model);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelLibrary::CppAdModelLibrary(const CppAdPrelinkedModel& prelinkedModel) : prelinkedModel_(&prelinkedModel) {
+  if (prelinkedModel.modelNames.count(prelinkedModel.modelName) == 0) {
+    throw std::runtime_error("[CppAdModelLibrary] The prelinked library does not contain the model " + prelinkedModel.modelName);
+  }
+  LoadedFunctionModel<scalar_t> model(prelinkedModel.modelName, getFunctionLoader(prelinkedModel));
+  setSparsity(model);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelLibrary::setSparsity(CppAD::cg::GenericModel<scalar_t>& model) {
+  if (model.isJacobianSparsityAvailable()) {
+    model.JacobianSparsity(jacobianNonzeroIndices_.rows, jacobianNonzeroIndices_.cols);
+  }
+  if (model.isHessianSparsityAvailable()) {
+    model.HessianSparsity(hessianNonzeroIndices_.rows, hessianNonzeroIndices_.cols);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelLibrary::model_ptr_t CppAdModelLibrary::createModel(const std::string& modelName) const {
+  std::lock_guard<std::mutex> lock(modelMutex_);
+  if (prelinkedModel_ != nullptr) {
+    if (prelinkedModel_->modelNames.count(modelName) == 0) {
+      return model_ptr_t(nullptr, ModelDeleter{nullptr});
+    }
+    return model_ptr_t(new LoadedFunctionModel<scalar_t>(modelName, getFunctionLoader(*prelinkedModel_)),
+                       ModelDeleter{shared_from_this()});
+  }
+  if (dynamicLib_->getModelNames().count(modelName) == 0) {
+    return model_ptr_t(nullptr, ModelDeleter{nullptr});
+  }
+  // The deleter keeps the library open as long as the model exists
+  return model_ptr_t(dynamicLib_->model(modelName).release(), ModelDeleter{shared_from_this()});
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelLibrary::single_precision_model_ptr_t CppAdModelLibrary::createSinglePrecisionModel(const std::string& modelName) const {
+  std::lock_guard<std::mutex> lock(modelMutex_);
+  if (prelinkedModel_ != nullptr) {
+    if (prelinkedModel_->modelNames.count(modelName) == 0) {
+      return single_precision_model_ptr_t(nullptr, ModelDeleter{nullptr});
+    }
+    return single_precision_model_ptr_t(new LoadedFunctionModel<float>(modelName, getFunctionLoader(*prelinkedModel_)),
+                                        ModelDeleter{shared_from_this()});
+  }
+  if (dynamicLib_->getModelNames().count(modelName) == 0) {
+    return single_precision_model_ptr_t(nullptr, ModelDeleter{nullptr});
+  }
+  // The double precision library cannot create float models, the functions are looked up in the library directly.
+  auto* dynamicLib = dynamicLib_.get();
+  auto functionLoader = [dynamicLib](const std::string& functionName, bool required) {
+    return dynamicLib->loadFunction(functionName, required);
+  };
+  return single_precision_model_ptr_t(new LoadedFunctionModel<float>(modelName, functionLoader), ModelDeleter{shared_from_this()});
+}
+
+}  // namespace ocs2
@@ -0,0 +1,201 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdPrelinkedModel.h>
+
+#include <fstream>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+
+namespace ocs2 {
+namespace cppad_prelinked {
+
+namespace {
+/** Checks whether a function is defined, not only declared, in a source. */
+bool isDefined(const std::string& functionName, const std::string& source) {
+  const std::string signatureStart = " " + functionName + "(";
+  for (auto pos = source.find(signatureStart); pos != std::string::npos; pos = source.find(signatureStart, pos + 1)) {
+    // Skip the parameter list, a definition continues with its body
+    int depth = 0;
+    auto end = pos + signatureStart.size() - 1;
+    for (; end < source.size(); ++end) {
+      depth += (source[end] == '(') ? 1 : (source[end] == ')') ? -1 : 0;
+      if (depth == 0) {
+        break;
+      }
+    }
+    const auto next = source.find_first_not_of(" \t\r\n", end + 1);
+    if (next != std::string::npos && source[next] == '{') {
+      return true;
+    }
+  }
+  return false;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::string> findModelFunctions(const std::string& modelName, const std::map<std::string, std::string>& sources) {
+  using source_gen_t = CppAD::cg::ModelCSourceGen<scalar_t>;
+  const std::vector<std::string> functions{source_gen_t::FUNCTION_INFO,
+                                           source_gen_t::FUNCTION_ATOMIC_FUNC_NAMES,
+                                           source_gen_t::FUNCTION_FORWAD_ZERO,
+                                           source_gen_t::FUNCTION_FORWARD_ONE,
+                                           source_gen_t::FUNCTION_REVERSE_ONE,
+                                           source_gen_t::FUNCTION_REVERSE_TWO,
+                                           source_gen_t::FUNCTION_JACOBIAN,
+                                           source_gen_t::FUNCTION_HESSIAN,
+                                           source_gen_t::FUNCTION_SPARSE_FORWARD_ONE,
+                                           source_gen_t::FUNCTION_SPARSE_REVERSE_ONE,
+                                           source_gen_t::FUNCTION_SPARSE_REVERSE_TWO,
+                                           source_gen_t::FUNCTION_SPARSE_JACOBIAN,
+                                           source_gen_t::FUNCTION_SPARSE_HESSIAN,
+                                           source_gen_t::FUNCTION_FORWARD_ONE_SPARSITY,
+                                           source_gen_t::FUNCTION_REVERSE_ONE_SPARSITY,
+                                           source_gen_t::FUNCTION_REVERSE_TWO_SPARSITY,
+                                           source_gen_t::FUNCTION_JACOBIAN_SPARSITY,
+                                           source_gen_t::FUNCTION_HESSIAN_SPARSITY,
+                                           source_gen_t::FUNCTION_HESSIAN_SPARSITY2};
+
+  std::vector<std::string> functionNames;
+  for (const auto& function : functions) {
+    const std::string functionName = modelName + "_" + function;
+    for (const auto& source : sources) {
+      if (isDefined(functionName, source.second)) {
+        functionNames.push_back(functionName);
+        break;
+      }
+    }
+  }
+  return functionNames;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeFunctionTable(const std::string& outputFolder, const CppAdPrelinkedModel& prelinkedModel,
+                        const std::vector<std::string>& functionNames) {
+  const std::string& modelName = prelinkedModel.modelName;
+  boost::filesystem::create_directories(outputFolder + "/include/ocs2_cppad_prelinked");
+
+  std::ofstream header(outputFolder + "/include/ocs2_cppad_prelinked/" + modelName + ".h");
+  header << "// Generated by ocs2_add_cppad_model(), do not edit.\n"
+            "#pragma once\n\n"
+            "#include <ocs2_core/automatic_differentiation/CppAdPrelinkedModel.h>\n\n"
+            "namespace ocs2 {\n"
+            "namespace cppad_prelinked {\n\n"
+            "/** The prelinked CppAD model "
+         << modelName
+         << ". */\n"
+            "const CppAdPrelinkedModel& "
+         << modelName
+         << "();\n\n"
+            "}  // namespace cppad_prelinked\n"
+            "}  // namespace ocs2\n";
+
+  std::ofstream source(outputFolder + "/" + modelName + "_prelinked.cpp");
+  source << "// Generated by ocs2_add_cppad_model(), do not edit.\n"
+            "#include <ocs2_cppad_prelinked/"
+         << modelName << ".h>\n\n";
+  // Only the addresses are taken, the C functions are called through the signatures known to CppAD.
+  source << "extern \"C\" {\n";
+  for (const auto& functionName : functionNames) {
+    source << "void " << functionName << "();\n";
+  }
+  source << "}\n\n"
+            "namespace ocs2 {\n"
+            "namespace cppad_prelinked {\n\n"
+            "const CppAdPrelinkedModel& "
+         << modelName
+         << "() {\n"
+            "  static const CppAdPrelinkedModel model{\""
+         << modelName << "\", " << prelinkedModel.variableDim << ", " << prelinkedModel.parameterDim << ",\n    {";
+  for (const auto& name : prelinkedModel.modelNames) {
+    source << "\"" << name << "\", ";
+  }
+  source << "},\n    {\n";
+  for (const auto& functionName : functionNames) {
+    source << "      {\"" << functionName << "\", reinterpret_cast<void*>(&" << functionName << ")},\n";
+  }
+  source << "    }};\n"
+            "  return model;\n"
+            "}\n\n"
+            "}  // namespace cppad_prelinked\n"
+            "}  // namespace ocs2\n";
+
+  if (!header || !source) {
+    throw std::runtime_error("[cppad_prelinked] Failed to write the function table of " + modelName + " to " + outputFolder);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int generatorMain(int argc, char* argv[], CppAdInterface& adInterface) {
+  if (argc != 4) {
+    std::cerr << "Usage: " << argv[0] << " <output folder> <model name> <Zero|First|Second>" << std::endl;
+    return 1;
+  }
+  const std::string outputFolder(argv[1]);
+  const std::string modelName(argv[2]);
+  const std::string order(argv[3]);
+
+  CppAdInterface::ApproximationOrder approximationOrder;
+  if (order == "Zero") {
+    approximationOrder = CppAdInterface::ApproximationOrder::Zero;
+  } else if (order == "First") {
+    approximationOrder = CppAdInterface::ApproximationOrder::First;
+  } else if (order == "Second") {
+    approximationOrder = CppAdInterface::ApproximationOrder::Second;
+  } else {
+    std::cerr << "[cppad_prelinked] Unknown approximation order: " << order << std::endl;
+    return 1;
+  }
+
+  if (adInterface.getModelName() != modelName) {
+    std::cerr << "[cppad_prelinked] The generator creates the model " << adInterface.getModelName() << " instead of " << modelName
+              << std::endl;
+    return 1;
+  }
+
+  try {
+    adInterface.generatePrelinkedModel(approximationOrder, outputFolder);
+  } catch (const std::exception& e) {
+    std::cerr << "[cppad_prelinked] Failed to generate " << modelName << ": " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace cppad_prelinked
+}  // namespace ocs2
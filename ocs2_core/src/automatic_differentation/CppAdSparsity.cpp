@@ -86,5 +86,80 @@ size_t getNumberOfNonZeros(const SparsityPattern& sparsityPattern) {
   return nnz;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+NonzeroIndices getNonzeroIndices(const SparsityPattern& sparsityPattern) {
+  NonzeroIndices indices;
+  indices.rows.reserve(getNumberOfNonZeros(sparsityPattern));
+  indices.cols.reserve(getNumberOfNonZeros(sparsityPattern));
+  for (size_t row = 0; row < sparsityPattern.size(); row++) {
+    for (const auto col : sparsityPattern[row]) {
+      indices.rows.push_back(row);
+      indices.cols.push_back(col);
+    }
+  }
+  return indices;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addToBlock(const NonzeroIndices& indices, const vector_t& nonzeros, size_t rowOffset, size_t colOffset, Eigen::Ref<matrix_t> block) {
+  assert(static_cast<size_t>(nonzeros.size()) == indices.size());
+  const size_t numRows = block.rows();
+  const size_t numCols = block.cols();
+  for (size_t i = 0; i < indices.size(); i++) {
+    // Unsigned wrap-around rejects the indices before the offset
+    const size_t row = indices.rows[i] - rowOffset;
+    const size_t col = indices.cols[i] - colOffset;
+    if (row < numRows && col < numCols) {
+      block(row, col) += nonzeros[i];
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addToBlockTransposed(const NonzeroIndices& indices, const vector_t& nonzeros, size_t rowOffset, size_t colOffset,
+                          Eigen::Ref<matrix_t> block) {
+  assert(static_cast<size_t>(nonzeros.size()) == indices.size());
+  const size_t numRows = block.cols();
+  const size_t numCols = block.rows();
+  for (size_t i = 0; i < indices.size(); i++) {
+    const size_t row = indices.rows[i] - rowOffset;
+    const size_t col = indices.cols[i] - colOffset;
+    if (row < numRows && col < numCols) {
+      block(col, row) += nonzeros[i];
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addToSymmetricBlock(const NonzeroIndices& indices, const vector_t& nonzeros, size_t rowOffset, size_t colOffset,
+                         Eigen::Ref<matrix_t> block) {
+  assert(static_cast<size_t>(nonzeros.size()) == indices.size());
+  const size_t numRows = block.rows();
+  const size_t numCols = block.cols();
+  for (size_t i = 0; i < indices.size(); i++) {
+    const size_t row = indices.rows[i] - rowOffset;
+    const size_t col = indices.cols[i] - colOffset;
+    if (row < numRows && col < numCols) {
+      block(row, col) += nonzeros[i];
+    }
+    if (indices.rows[i] != indices.cols[i]) {
+      // Mirrored element of the lower triangular part
+      const size_t mirroredRow = indices.cols[i] - rowOffset;
+      const size_t mirroredCol = indices.rows[i] - colOffset;
+      if (mirroredRow < numRows && mirroredCol < numCols) {
+        block(mirroredRow, mirroredCol) += nonzeros[i];
+      }
+    }
+  }
+}
+
 }  // namespace cppad_sparsity
 }  // namespace ocs2
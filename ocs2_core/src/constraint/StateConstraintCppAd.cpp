@@ -68,9 +68,10 @@ StateConstraintCppAd::StateConstraintCppAd(const StateConstraintCppAd& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t StateConstraintCppAd::getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const {
-  vector_t tapedTimeState(1 + state.rows());
-  tapedTimeState << time, state;
-  return adInterfacePtr_->getFunctionValue(tapedTimeState, getParameters(time, preComputation));
+  tapedTimeState_.resize(1 + state.rows());
+  tapedTimeState_ << time, state;
+  updateParameters(time, preComputation, parameters_);
+  return adInterfacePtr_->getFunctionValue(tapedTimeState_, parameters_);
 }
 
 /******************************************************************************************************/
@@ -81,13 +82,13 @@ VectorFunctionLinearApproximation StateConstraintCppAd::getLinearApproximation(s
   VectorFunctionLinearApproximation constraint;
 
   const size_t stateDim = state.rows();
-  const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
-  tapedTimeState << time, state;
+  updateParameters(time, preComputation, parameters_);
+  tapedTimeState_.resize(1 + stateDim);
+  tapedTimeState_ << time, state;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  constraint.dfdx = J.rightCols(stateDim);
+  adInterfacePtr_->getValueAndSparseJacobian(tapedTimeState_, parameters_, constraint.f, jacobianNonzeros_);
+  constraint.dfdx.setZero(constraint.f.rows(), stateDim);
+  cppad_sparsity::addToBlock(adInterfacePtr_->getJacobianNonzeroIndices(), jacobianNonzeros_, 0, 1, constraint.dfdx);
 
   return constraint;
 }
@@ -104,21 +105,28 @@ VectorFunctionQuadraticApproximation StateConstraintCppAd::getQuadraticApproxima
   VectorFunctionQuadraticApproximation constraint;
 
   const size_t stateDim = state.rows();
-  const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
-  tapedTimeState << time, state;
-
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  constraint.dfdx = J.rightCols(stateDim);
+  updateParameters(time, preComputation, parameters_);
+  tapedTimeState_.resize(1 + stateDim);
+  tapedTimeState_ << time, state;
 
+  // Accumulate the sparse derivatives directly into the blocks of the approximation. Index 0 of the taped variables is the time.
+  adInterfacePtr_->getValueAndSparseJacobian(tapedTimeState_, parameters_, constraint.f, jacobianNonzeros_);
   const size_t numConstraints = constraint.f.rows();
+  constraint.dfdx.setZero(numConstraints, stateDim);
+  cppad_sparsity::addToBlock(adInterfacePtr_->getJacobianNonzeroIndices(), jacobianNonzeros_, 0, 1, constraint.dfdx);
+
+  // The Hessian of constraint i is the weighted Hessian with the i-th unit weight
+  const auto& hessianIndices = adInterfacePtr_->getHessianNonzeroIndices();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  weights_.setZero(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeState, params);
-    constraint.dfdxx[i] = H.bottomRightCorner(stateDim, stateDim);
+    weights_(i) = 1.0;
+    adInterfacePtr_->getSparseHessian(weights_, tapedTimeState_, parameters_, hessianNonzeros_);
+    weights_(i) = 0.0;
+    constraint.dfdxx[i].setZero(stateDim, stateDim);
+    cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1, 1, constraint.dfdxx[i]);
   }
 
   return constraint;
@@ -70,9 +70,10 @@ StateInputConstraintCppAd::StateInputConstraintCppAd(const StateInputConstraintC
 /******************************************************************************************************/
 vector_t StateInputConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                              const PreComputation& preComputation) const {
-  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
-  tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, preComputation));
+  tapedTimeStateInput_.resize(1 + state.rows() + input.rows());
+  tapedTimeStateInput_ << time, state, input;
+  updateParameters(time, preComputation, parameters_);
+  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters_);
 }
 
 /******************************************************************************************************/
@@ -85,14 +86,16 @@ VectorFunctionLinearApproximation StateInputConstraintCppAd::getLinearApproximat
 
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
-  const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
+  updateParameters(time, preComputation, parameters_);
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  adInterfacePtr_->getValueAndSparseJacobian(tapedTimeStateInput_, parameters_, constraint.f, jacobianNonzeros_);
+  const auto& jacobianIndices = adInterfacePtr_->getJacobianNonzeroIndices();
+  constraint.dfdx.setZero(constraint.f.rows(), stateDim);
+  constraint.dfdu.setZero(constraint.f.rows(), inputDim);
+  cppad_sparsity::addToBlock(jacobianIndices, jacobianNonzeros_, 0, 1, constraint.dfdx);
+  cppad_sparsity::addToBlock(jacobianIndices, jacobianNonzeros_, 0, 1 + stateDim, constraint.dfdu);
 
   return constraint;
 }
@@ -111,24 +114,35 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
 
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
-  const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
-
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  updateParameters(time, preComputation, parameters_);
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
+  // Accumulate the sparse derivatives directly into the blocks of the approximation. Index 0 of the taped variables is the time.
+  adInterfacePtr_->getValueAndSparseJacobian(tapedTimeStateInput_, parameters_, constraint.f, jacobianNonzeros_);
   const size_t numConstraints = constraint.f.rows();
+  const auto& jacobianIndices = adInterfacePtr_->getJacobianNonzeroIndices();
+  constraint.dfdx.setZero(numConstraints, stateDim);
+  constraint.dfdu.setZero(numConstraints, inputDim);
+  cppad_sparsity::addToBlock(jacobianIndices, jacobianNonzeros_, 0, 1, constraint.dfdx);
+  cppad_sparsity::addToBlock(jacobianIndices, jacobianNonzeros_, 0, 1 + stateDim, constraint.dfdu);
+
+  // The Hessian of constraint i is the weighted Hessian with the i-th unit weight
+  const auto& hessianIndices = adInterfacePtr_->getHessianNonzeroIndices();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  weights_.setZero(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
-    constraint.dfdxx[i] = H.block(1, 1, stateDim, stateDim);
-    constraint.dfdux[i] = H.block(1 + stateDim, 1, inputDim, stateDim);
-    constraint.dfduu[i] = H.bottomRightCorner(inputDim, inputDim);
+    weights_(i) = 1.0;
+    adInterfacePtr_->getSparseHessian(weights_, tapedTimeStateInput_, parameters_, hessianNonzeros_);
+    weights_(i) = 0.0;
+    constraint.dfdxx[i].setZero(stateDim, stateDim);
+    constraint.dfdux[i].setZero(inputDim, stateDim);
+    constraint.dfduu[i].setZero(inputDim, inputDim);
+    cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1, 1, constraint.dfdxx[i]);
+    cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1 + stateDim, 1, constraint.dfdux[i]);
+    cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1 + stateDim, 1 + stateDim, constraint.dfduu[i]);
   }
 
   return constraint;
@@ -87,7 +87,9 @@ void FeedforwardController::setController(const scalar_array_t& controllerTime,
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
-  return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
+  // thread-local, see LinearController::computeInput
+  thread_local LinearInterpolation::TimeSegmentCursor timeSegmentCursor;
+  return LinearInterpolation::interpolate(timeSegmentCursor.timeSegment(t, timeStamp_), uffArray_);
 }
 
 /******************************************************************************************************/
@@ -77,13 +77,63 @@ void LinearController::setController(const scalar_array_t& controllerTime, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
+  vector_t u;
+  computeInput(t, x, u);
+  return u;
+}
 
-  vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInput(scalar_t t, const vector_t& x, vector_t& u) {
+  assert(!biasArray_.empty());
+  // The cursor only speeds up sequential lookups, its result does not depend on the previous queries. It is thread-local, such that
+  // computeInput does not modify the controller and can be called concurrently.
+  thread_local LinearInterpolation::TimeSegmentCursor timeSegmentCursor;
+  const auto indexAlpha = timeSegmentCursor.timeSegment(t, timeStamp_);
+
+  // Constant controller
+  if (biasArray_.size() == 1) {
+    u = biasArray_.front();
+    u.noalias() += gainArray_.front() * x;
+    return;
+  }
+
+  // As in LinearInterpolation::interpolate, snap to the closest data point if the sizes do not match
+  const int index = indexAlpha.first;
+  const scalar_t alpha = indexAlpha.second;
+  const auto& lhsBias = biasArray_[index];
+  const auto& rhsBias = biasArray_[index + 1];
+  const auto& lhsGain = gainArray_[index];
+  const auto& rhsGain = gainArray_[index + 1];
+
+  if (lhsBias.size() == rhsBias.size()) {
+    u = alpha * lhsBias + (1.0 - alpha) * rhsBias;
+  } else {
+    u = (alpha > 0.5) ? lhsBias : rhsBias;
+  }
 
-  uff.noalias() += k * x;
-  return uff;
+  if (lhsGain.rows() == rhsGain.rows() && lhsGain.cols() == rhsGain.cols()) {
+    u.noalias() += alpha * (lhsGain * x);
+    u.noalias() += (1.0 - alpha) * (rhsGain * x);
+  } else {
+    u.noalias() += ((alpha > 0.5) ? lhsGain : rhsGain) * x;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInputs(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory,
+                                     vector_array_t& inputTrajectory) {
+  if (timeTrajectory.size() != stateTrajectory.size()) {
+    throw std::runtime_error("[LinearController::computeInputs] timeTrajectory and stateTrajectory must have the same size.");
+  }
+
+  inputTrajectory.resize(timeTrajectory.size());
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    computeInput(timeTrajectory[i], stateTrajectory[i], inputTrajectory[i]);
+  }
 }
 
 /******************************************************************************************************/
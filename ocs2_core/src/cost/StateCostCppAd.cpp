@@ -63,9 +63,11 @@ StateCostCppAd::StateCostCppAd(const StateCostCppAd& rhs)
 /******************************************************************************************************/
 scalar_t StateCostCppAd::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
                                   const PreComputation& preComputation) const {
-  vector_t tapedTimeState(1 + state.rows());
-  tapedTimeState << time, state;
-  return adInterfacePtr_->getFunctionValue(tapedTimeState, getParameters(time, targetTrajectories, preComputation))(0);
+  tapedTimeState_.resize(1 + state.rows());
+  tapedTimeState_ << time, state;
+  updateParameters(time, targetTrajectories, preComputation, parameters_);
+  adInterfacePtr_->getFunctionValue(tapedTimeState_, parameters_, value_);
+  return value_(0);
 }
 
 /******************************************************************************************************/
@@ -77,17 +79,19 @@ ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(s
   ScalarFunctionQuadraticApproximation cost;
 
   const size_t stateDim = state.rows();
-  const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
-  tapedTimeState << time, state;
+  updateParameters(time, targetTrajectories, preComputation, parameters_);
+  tapedTimeState_.resize(1 + stateDim);
+  tapedTimeState_ << time, state;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
+  adInterfacePtr_->getValueAndSparseDerivatives(weights_, tapedTimeState_, parameters_, value_, jacobianNonzeros_, hessianNonzeros_);
+  cost.f = value_(0);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  cost.dfdx = J.rightCols(stateDim).transpose();
+  // Accumulate the sparse derivatives directly into the blocks of the approximation. Index 0 of the taped variables is the time.
+  cost.dfdx.setZero(stateDim);
+  cppad_sparsity::addToBlockTransposed(adInterfacePtr_->getJacobianNonzeroIndices(), jacobianNonzeros_, 0, 1, cost.dfdx);
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeState, params);
-  cost.dfdxx = H.bottomRightCorner(stateDim, stateDim);
+  cost.dfdxx.setZero(stateDim, stateDim);
+  cppad_sparsity::addToSymmetricBlock(adInterfacePtr_->getHessianNonzeroIndices(), hessianNonzeros_, 1, 1, cost.dfdxx);
 
   return cost;
 }
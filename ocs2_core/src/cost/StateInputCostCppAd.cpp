@@ -64,9 +64,11 @@ StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
 /******************************************************************************************************/
 scalar_t StateInputCostCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const {
-  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
-  tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation))(0);
+  tapedTimeStateInput_.resize(1 + state.rows() + input.rows());
+  tapedTimeStateInput_ << time, state, input;
+  updateParameters(time, targetTrajectories, preComputation, parameters_);
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters_, value_);
+  return value_(0);
 }
 
 /******************************************************************************************************/
@@ -80,20 +82,27 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
 
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
-  const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
-
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
-
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  cost.dfdx = J.middleCols(1, stateDim).transpose();
-  cost.dfdu = J.rightCols(inputDim).transpose();
-
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
-  cost.dfdxx = H.block(1, 1, stateDim, stateDim);
-  cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
-  cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
+  updateParameters(time, targetTrajectories, preComputation, parameters_);
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
+
+  adInterfacePtr_->getValueAndSparseDerivatives(weights_, tapedTimeStateInput_, parameters_, value_, jacobianNonzeros_, hessianNonzeros_);
+  cost.f = value_(0);
+
+  // Accumulate the sparse derivatives directly into the blocks of the approximation. Index 0 of the taped variables is the time.
+  const auto& jacobianIndices = adInterfacePtr_->getJacobianNonzeroIndices();
+  cost.dfdx.setZero(stateDim);
+  cost.dfdu.setZero(inputDim);
+  cppad_sparsity::addToBlockTransposed(jacobianIndices, jacobianNonzeros_, 0, 1, cost.dfdx);
+  cppad_sparsity::addToBlockTransposed(jacobianIndices, jacobianNonzeros_, 0, 1 + stateDim, cost.dfdu);
+
+  const auto& hessianIndices = adInterfacePtr_->getHessianNonzeroIndices();
+  cost.dfdxx.setZero(stateDim, stateDim);
+  cost.dfdux.setZero(inputDim, stateDim);
+  cost.dfduu.setZero(inputDim, inputDim);
+  cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1, 1, cost.dfdxx);
+  cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1 + stateDim, 1, cost.dfdux);
+  cppad_sparsity::addToSymmetricBlock(hessianIndices, hessianNonzeros_, 1 + stateDim, 1 + stateDim, cost.dfduu);
 
   return cost;
 }
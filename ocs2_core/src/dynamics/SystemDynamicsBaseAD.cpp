@@ -83,14 +83,16 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
       new CppAdInterface(guardSurfaces, 1 + stateDim, getNumGuardSurfacesParameters(), modelName + "_guard_surfaces", modelFolder));
 
   if (recompileLibraries) {
-    flowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    flowMapADInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    jumpMapADInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    guardSurfacesADInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    flowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    flowMapADInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    jumpMapADInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    guardSurfacesADInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
   }
+  // The models are compiled concurrently, within a CppAdDeferredWait the caller waits for them
+  CppAdInterface::waitForModels({flowMapADInterfacePtr_.get(), jumpMapADInterfacePtr_.get(), guardSurfacesADInterfacePtr_.get()});
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/AllocationCounter.h"
+
+#include <atomic>
+#include <sstream>
+
+namespace ocs2 {
+namespace benchmark {
+
+namespace {
+// Constant initialized, hence valid for allocations made during static initialization.
+std::atomic<bool> allocationCounterInstalled{false};
+std::atomic<size_t> numAllocations{0};
+std::atomic<size_t> numBytes{0};
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isAllocationCounterInstalled() {
+  return allocationCounterInstalled.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AllocationStatistics getAllocationStatistics() {
+  AllocationStatistics statistics;
+  statistics.numAllocations = numAllocations.load(std::memory_order_relaxed);
+  statistics.numBytes = numBytes.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void internal::markAllocationCounterInstalled() {
+  allocationCounterInstalled.store(true, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void internal::countAllocation(size_t bytes) {
+  numAllocations.fetch_add(1, std::memory_order_relaxed);
+  numBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(const RepeatedAllocationCounter& counter) {
+  if (counter.getNumMeasuredIntervals() == 0) {
+    return "0 (0 [kB])";
+  }
+  std::stringstream stream;
+  stream << counter.getAverageAllocations() << " (" << counter.getAverageBytes() / 1024.0 << " [kB])";
+  return stream.str();
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
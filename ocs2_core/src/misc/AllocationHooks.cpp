@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+/*
+ * Heap allocation hooks for the allocation statistics of ocs2_core/misc/AllocationCounter.h. This file is compiled into the separate
+ * ocs2_core_allocation_hooks library, such that only executables that link against it (benchmarks, tests) pay for the counting.
+ *
+ * On glibc, the C allocation functions are replaced and forwarded to the glibc implementations. This covers Eigen, which allocates
+ * with std::malloc, as well as operator new, which is implemented on top of malloc. On other platforms, only the global operator new
+ * is replaced.
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#include "ocs2_core/misc/AllocationCounter.h"
+
+namespace {
+struct AllocationHooksInstaller {
+  AllocationHooksInstaller() { ocs2::benchmark::internal::markAllocationCounterInstalled(); }
+};
+const AllocationHooksInstaller allocationHooksInstaller;
+}  // unnamed namespace
+
+#if defined(__GLIBC__)
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) {
+  ocs2::benchmark::internal::countAllocation(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) {
+  ocs2::benchmark::internal::countAllocation(num * size);
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  ocs2::benchmark::internal::countAllocation(size);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+  ocs2::benchmark::internal::countAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  ocs2::benchmark::internal::countAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+  // POSIX requires a power of two multiple of sizeof(void*), and *ptr must not be modified on failure
+  const bool isPowerOfTwo = alignment != 0 && (alignment & (alignment - 1)) == 0;
+  if (!isPowerOfTwo || alignment % sizeof(void*) != 0) {
+    return EINVAL;
+  }
+  ocs2::benchmark::internal::countAllocation(size);
+  void* alignedPtr = __libc_memalign(alignment, size);
+  if (alignedPtr == nullptr) {
+    return ENOMEM;
+  }
+  *ptr = alignedPtr;
+  return 0;
+}
+}  // extern "C"
+
+#else
+
+void* operator new(std::size_t size) {
+  ocs2::benchmark::internal::countAllocation(size);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+#endif
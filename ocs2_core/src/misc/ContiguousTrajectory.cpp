@@ -0,0 +1,78 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/ContiguousTrajectory.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContiguousTrajectory::resize(const std::vector<int>& sizes) {
+  sizes_ = sizes;
+  stride_ = sizes_.empty() ? 0 : *std::max_element(sizes_.cbegin(), sizes_.cend());
+
+  const Eigen::Index requiredSize = static_cast<Eigen::Index>(stride_) * static_cast<Eigen::Index>(sizes_.size());
+  if (storage_.size() < requiredSize) {
+    storage_.resize(requiredSize);
+  }
+  setZero();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContiguousTrajectory::assign(const vector_array_t& trajectory) {
+  const bool sameLayout = trajectory.size() == sizes_.size() &&
+                          std::equal(trajectory.cbegin(), trajectory.cend(), sizes_.cbegin(),
+                                     [](const vector_t& v, int size) { return v.size() == size; });
+  if (!sameLayout) {
+    std::vector<int> sizes(trajectory.size());
+    std::transform(trajectory.cbegin(), trajectory.cend(), sizes.begin(), [](const vector_t& v) { return static_cast<int>(v.size()); });
+    resize(sizes);
+  }
+
+  for (size_t i = 0; i < trajectory.size(); i++) {
+    (*this)[i] = trajectory[i];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContiguousTrajectory::toVectorArray(vector_array_t& trajectory) const {
+  trajectory.resize(sizes_.size());
+  for (size_t i = 0; i < sizes_.size(); i++) {
+    trajectory[i] = (*this)[i];
+  }
+}
+
+}  // namespace ocs2
@@ -65,7 +65,7 @@ void TargetTrajectories::clear() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
-bool TargetTrajectories::operator==(const TargetTrajectories& other) {
+bool TargetTrajectories::operator==(const TargetTrajectories& other) const {
   return this->timeTrajectory == other.timeTrajectory && this->stateTrajectory == other.stateTrajectory &&
          this->inputTrajectory == other.inputTrajectory;
 }
@@ -77,7 +77,9 @@ vector_t TargetTrajectories::getDesiredState(scalar_t time) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
+    // The cursor does not change the result, see LinearController::computeInput
+    thread_local LinearInterpolation::TimeSegmentCursor timeSegmentCursor;
+    return LinearInterpolation::interpolate(timeSegmentCursor.timeSegment(time, timeTrajectory), stateTrajectory);
   }
 }
 
@@ -90,7 +92,8 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   } else if (inputTrajectory.empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, inputTrajectory);
+    thread_local LinearInterpolation::TimeSegmentCursor timeSegmentCursor;
+    return LinearInterpolation::interpolate(timeSegmentCursor.timeSegment(time, timeTrajectory), inputTrajectory);
   }
 }
 
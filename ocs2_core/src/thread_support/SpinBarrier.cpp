@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/thread_support/SpinBarrier.h>
+
+#include <stdexcept>
+#include <thread>
+
+namespace ocs2 {
+
+namespace {
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+/** Whether the participants cannot all run at the same time. */
+bool isOversubscribed(size_t numParticipants) {
+  const auto numHardwareThreads = std::thread::hardware_concurrency();  // 0 if unknown
+  return numHardwareThreads > 0 && numParticipants > numHardwareThreads;
+}
+}  // unnamed namespace
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+constexpr size_t SpinBarrier::defaultSpinIterations;
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+SpinBarrier::SpinBarrier(size_t numParticipants, size_t spinIterations)
+    : numParticipants_(static_cast<int>(numParticipants)),
+      spinIterations_(isOversubscribed(numParticipants) ? 0 : spinIterations),
+      numRemaining_(numParticipants_) {
+  if (numParticipants == 0) {
+    throw std::invalid_argument("[SpinBarrier] The number of participants should be at least 1.");
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void SpinBarrier::release() {
+  generation_.fetch_add(1, std::memory_order_seq_cst);
+  if (numParked_.load(std::memory_order_seq_cst) > 0) {
+    { std::lock_guard<std::mutex> lock(parkingLock_); }
+    parkingCondition_.notify_all();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void SpinBarrier::waitForRelease(uint32_t generation) {
+  for (size_t i = 0; i < spinIterations_; ++i) {
+    if (generation_.load(std::memory_order_acquire) != generation) {
+      return;
+    }
+    cpuRelax();
+  }
+
+  std::unique_lock<std::mutex> lock(parkingLock_);
+  numParked_.fetch_add(1, std::memory_order_seq_cst);
+  parkingCondition_.wait(lock, [&] { return generation_.load(std::memory_order_seq_cst) != generation; });
+  numParked_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}  // namespace ocs2
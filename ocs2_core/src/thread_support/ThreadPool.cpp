@@ -27,19 +27,91 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <limits>
+
 namespace ocs2 {
 
+namespace {
+// The pool and the worker index of the current thread, used to push tasks submitted from a worker to its own deque.
+thread_local const ThreadPool* currentPoolPtr = nullptr;
+thread_local int currentWorkerIndex = -1;
+
+// A block [begin, end) of a parallel job is packed into a single 64 bit word such that it can be claimed with one CAS.
+inline uint64_t packRange(uint32_t begin, uint32_t end) {
+  return (static_cast<uint64_t>(begin) << 32U) | static_cast<uint64_t>(end);
+}
+inline uint32_t rangeBegin(uint64_t range) {
+  return static_cast<uint32_t>(range >> 32U);
+}
+inline uint32_t rangeEnd(uint64_t range) {
+  return static_cast<uint32_t>(range & std::numeric_limits<uint32_t>::max());
+}
+
+constexpr size_t cacheLineSize = 64;
+}  // unnamed namespace
+
+/**
+ * Task deque of a single worker.
+ */
+struct ThreadPool::WorkerQueue {
+  std::mutex lock;
+  std::deque<std::unique_ptr<TaskBase>> tasks;  // protected by lock
+};
+
+/**
+ * Descriptor of a runParallel() or parallelFor() call. The descriptors are owned by the pool and recycled between calls.
+ */
+struct ThreadPool::ParallelJob {
+  /** The block of indices of one participant, padded to a cache line to avoid false sharing between participants. */
+  struct Slot {
+    std::atomic<uint64_t> range{0};
+    char padding[cacheLineSize - sizeof(std::atomic<uint64_t>)];
+  };
+
+  explicit ParallelJob(size_t numWorkers) : slots(numWorkers + 1), joined(numWorkers, 0) {}
+
+  job_body_t body{nullptr};
+  void* functorPtr{nullptr};
+  int offset{0};
+  int numIndices{0};
+  int grain{1};
+  bool skipAfterException{false};
+
+  std::vector<Slot> slots;   // one per worker, the last one belongs to the calling thread
+  std::vector<char> joined;  // whether a worker has joined the job, protected by jobsLock_
+  ParallelJob* next{nullptr};  // intrusive list of active jobs, protected by jobsLock_
+
+  std::atomic_int numProcessed{0};
+  std::atomic_int numActiveWorkers{0};
+  std::atomic_bool failed{false};
+
+  std::mutex exceptionLock;
+  std::exception_ptr exception;  // protected by exceptionLock
+};
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, const std::vector<int>& cpuAffinity) {
+  workerQueues_.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; i++) {
+    workerQueues_.emplace_back(new WorkerQueue);
+  }
+
+  if (nThreads > 0) {
+    jobStorage_.emplace_back(new ParallelJob(nThreads));
+    freeJobs_.push_back(jobStorage_.back().get());
+  }
+
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    setWorkerThreadAffinity(cpuAffinity, i, workerThreads_.back());
   }
 }
 
@@ -48,10 +120,10 @@ ThreadPool::ThreadPool(size_t nThreads, int priority) {
 /**************************************************************************************************/
 ThreadPool::~ThreadPool() {
   {  // set exit flag, wake up threads and join
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    std::lock_guard<std::mutex> lock(jobsLock_);
     stop_ = true;
   }
-  taskQueueCondition_.notify_all();
+  workerCondition_.notify_all();
   for (auto& thread : workerThreads_) {
     if (thread.joinable()) {
       thread.join();
@@ -63,26 +135,30 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  currentPoolPtr = this;
+  currentWorkerIndex = workerIndex;
+
   while (true) {
-    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
-    {
-      std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+    auto taskPtr = popTask(workerIndex);
+    if (taskPtr) {
+      taskPtr->operator()(workerIndex);
+      continue;
+    }
 
-      // exit condition
-      if (stop_) {
-        break;
-      }
+    ParallelJob* jobPtr = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(jobsLock_);
+      workerCondition_.wait(lock, [&] { return stop_ || numQueuedTasks_ > 0 || (jobPtr = joinActiveJob(workerIndex)) != nullptr; });
+    }
 
-      // pop the first task
-      if (!taskQueue_.empty()) {
-        taskPtr = std::move(taskQueue_.front());
-        taskQueue_.pop();
-      }
+    if (jobPtr != nullptr) {
+      executeJob(*jobPtr, workerIndex, workerIndex);
+      jobPtr->numActiveWorkers.fetch_sub(1, std::memory_order_release);
     }
 
-    if (taskPtr) {
-      taskPtr->operator()(workerIndex);
+    // exit condition
+    if (stop_) {
+      break;
     }
   }
 }
@@ -91,34 +167,223 @@ void ThreadPool::worker(int workerIndex) {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
+  // Tasks submitted from a worker of this pool go to its own deque, others are distributed round-robin.
+  const size_t queueIndex = (currentPoolPtr == this) ? static_cast<size_t>(currentWorkerIndex)
+                                                     : nextQueueIndex_.fetch_add(1, std::memory_order_relaxed) % workerQueues_.size();
   {
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
-    taskQueue_.push(std::move(taskPtr));
+    auto& queue = *workerQueues_[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.lock);
+    queue.tasks.push_back(std::move(taskPtr));
   }
-  taskQueueCondition_.notify_one();
+  {
+    std::lock_guard<std::mutex> lock(jobsLock_);
+    ++numQueuedTasks_;
+  }
+  workerCondition_.notify_one();
 }
 
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
-  // Launch tasks in helper threads
-  std::vector<std::future<void>> futures;
-  if (N > 1) {
-    const int numHelpers = N - 1;
-    futures.reserve(numHelpers);
-    for (int i = 0; i < numHelpers; ++i) {
-      futures.emplace_back(run(taskFunction));
+std::unique_ptr<ThreadPool::TaskBase> ThreadPool::popTask(int workerIndex) {
+  std::unique_ptr<TaskBase> taskPtr;
+  if (numQueuedTasks_.load(std::memory_order_acquire) <= 0) {
+    return taskPtr;
+  }
+
+  // own deque: LIFO
+  {
+    auto& queue = *workerQueues_[workerIndex];
+    std::lock_guard<std::mutex> lock(queue.lock);
+    if (!queue.tasks.empty()) {
+      taskPtr = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+  }
+
+  // steal from the other deques: FIFO
+  const size_t numQueues = workerQueues_.size();
+  for (size_t k = 1; !taskPtr && k < numQueues; ++k) {
+    auto& queue = *workerQueues_[(workerIndex + k) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.lock);
+    if (!queue.tasks.empty()) {
+      taskPtr = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
     }
   }
 
-  // Execute one instance in this thread.
-  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
-  taskFunction(workerId);
+  if (taskPtr) {
+    --numQueuedTasks_;
+  }
+  return taskPtr;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ThreadPool::ParallelJob& ThreadPool::publishJob(job_body_t body, void* functorPtr, int begin, int end, int grain, bool includeCaller,
+                                                   bool skipAfterException) {
+  std::unique_lock<std::mutex> lock(jobsLock_);
+
+  // recycle a job descriptor, only allocates if more callers than ever before use the pool concurrently
+  if (freeJobs_.empty()) {
+    jobStorage_.emplace_back(new ParallelJob(numThreads()));
+    freeJobs_.push_back(jobStorage_.back().get());
+  }
+  ParallelJob& job = *freeJobs_.back();
+  freeJobs_.pop_back();
+
+  job.body = body;
+  job.functorPtr = functorPtr;
+  job.offset = begin;
+  job.numIndices = end - begin;
+  job.grain = grain;
+  job.skipAfterException = skipAfterException;
+  job.numProcessed.store(0, std::memory_order_relaxed);
+  job.numActiveWorkers.store(0, std::memory_order_relaxed);
+  job.failed.store(false, std::memory_order_relaxed);
+  job.exception = nullptr;
+  std::fill(job.joined.begin(), job.joined.end(), 0);
+
+  // split the range into one contiguous block per participant
+  const auto numParticipants = static_cast<uint32_t>(includeCaller ? job.slots.size() : job.slots.size() - 1);
+  const auto numIndices = static_cast<uint32_t>(job.numIndices);
+  for (uint32_t p = 0; p < job.slots.size(); ++p) {
+    const uint32_t blockBegin = (p < numParticipants) ? (p * numIndices) / numParticipants : numIndices;
+    const uint32_t blockEnd = (p < numParticipants) ? ((p + 1) * numIndices) / numParticipants : numIndices;
+    job.slots[p].range.store(packRange(blockBegin, blockEnd), std::memory_order_relaxed);
+  }
+
+  // activate
+  job.next = activeJobs_;
+  activeJobs_ = &job;
+  lock.unlock();
+  workerCondition_.notify_all();
+
+  return job;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ThreadPool::ParallelJob* ThreadPool::joinActiveJob(int workerIndex) {
+  for (auto* jobPtr = activeJobs_; jobPtr != nullptr; jobPtr = jobPtr->next) {
+    if (jobPtr->joined[workerIndex] == 0) {
+      jobPtr->joined[workerIndex] = 1;
+      jobPtr->numActiveWorkers.fetch_add(1, std::memory_order_relaxed);
+      return jobPtr;
+    }
+  }
+  return nullptr;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::executeJob(ParallelJob& job, int slot, int workerIndex) {
+  const auto numSlots = static_cast<int>(job.slots.size());
+  const auto grain = static_cast<uint32_t>(job.grain);
+  auto& ownRange = job.slots[slot].range;
+
+  while (true) {
+    // claim a chunk from the front of the own block
+    uint64_t range = ownRange.load(std::memory_order_acquire);
+    uint32_t begin = rangeBegin(range);
+    uint32_t end = rangeEnd(range);
+    while (begin < end) {
+      const uint32_t chunkEnd = std::min(begin + grain, end);
+      if (ownRange.compare_exchange_weak(range, packRange(chunkEnd, end), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        end = chunkEnd;
+        break;
+      }
+      begin = rangeBegin(range);
+      end = rangeEnd(range);
+    }
+
+    if (begin < end) {
+      if (!job.skipAfterException || !job.failed.load(std::memory_order_relaxed)) {
+        try {
+          job.body(job.functorPtr, workerIndex, job.offset + static_cast<int>(begin), job.offset + static_cast<int>(end));
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(job.exceptionLock);
+          if (!job.failed) {
+            job.exception = std::current_exception();
+            job.failed = true;
+          }
+        }
+      }
+      job.numProcessed.fetch_add(static_cast<int>(end - begin), std::memory_order_release);
+      continue;
+    }
+
+    // own block is exhausted: steal the back half of another block into the own slot
+    bool stolen = false;
+    for (int k = 1; !stolen && k < numSlots; ++k) {
+      auto& victimRange = job.slots[(slot + k) % numSlots].range;
+      range = victimRange.load(std::memory_order_acquire);
+      begin = rangeBegin(range);
+      end = rangeEnd(range);
+      while (begin < end) {
+        const uint32_t numStolen = std::min(std::max(grain, (end - begin) / 2), end - begin);
+        if (victimRange.compare_exchange_weak(range, packRange(begin, end - numStolen), std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+          ownRange.store(packRange(end - numStolen, end), std::memory_order_release);
+          stolen = true;
+          break;
+        }
+        begin = rangeBegin(range);
+        end = rangeEnd(range);
+      }
+    }
+
+    if (!stolen) {
+      return;
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::completeJob(ParallelJob& job, std::exception_ptr callerException) {
+  const auto callerSlot = static_cast<int>(numThreads());
+
+  // help with the remaining work and wait for the workers to process their claimed chunks
+  executeJob(job, callerSlot, callerSlot);
+  while (job.numProcessed.load(std::memory_order_acquire) < job.numIndices) {
+    std::this_thread::yield();
+  }
+
+  // deactivate, then wait until no worker refers to the job anymore
+  {
+    std::lock_guard<std::mutex> lock(jobsLock_);
+    for (auto** jobPtrPtr = &activeJobs_; *jobPtrPtr != nullptr; jobPtrPtr = &(*jobPtrPtr)->next) {
+      if (*jobPtrPtr == &job) {
+        *jobPtrPtr = job.next;
+        break;
+      }
+    }
+  }
+  while (job.numActiveWorkers.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+
+  std::exception_ptr workerException;
+  {
+    std::lock_guard<std::mutex> lock(job.exceptionLock);
+    workerException = std::move(job.exception);
+    job.exception = nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(jobsLock_);
+    job.next = nullptr;
+    freeJobs_.push_back(&job);
+  }
 
-  // Wait for helpers to finish.
-  for (auto&& fut : futures) {
-    fut.get();
+  if (callerException) {
+    std::rethrow_exception(callerException);
+  } else if (workerException) {
+    std::rethrow_exception(workerException);
   }
 }
 
@@ -0,0 +1,128 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/thread_support/WorkerTeam.h>
+
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+#include <ocs2_core/thread_support/SetThreadPriority.h>
+
+namespace ocs2 {
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+WorkerTeam::WorkerTeam(size_t teamSize, int priority, const std::vector<int>& cpuAffinity, size_t spinIterations)
+    : teamSize_(std::max(teamSize, size_t(1))),
+      startBarrier_(teamSize_, spinIterations),
+      finishBarrier_(teamSize_, spinIterations),
+      taskBarrier_(teamSize_, spinIterations),
+      reductionSlots_(teamSize_) {
+  workerThreads_.reserve(teamSize_ - 1);
+  for (size_t i = 0; i < teamSize_ - 1; i++) {
+    workerThreads_.emplace_back(&WorkerTeam::worker, this, i);
+    setThreadPriority(priority, workerThreads_.back());
+    setWorkerThreadAffinity(cpuAffinity, i, workerThreads_.back());
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+WorkerTeam::~WorkerTeam() {
+  if (!workerThreads_.empty()) {
+    stop_ = true;
+    startBarrier_.arriveAndWait();
+    for (auto& thread : workerThreads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void WorkerTeam::worker(int workerIndex) {
+  while (true) {
+    startBarrier_.arriveAndWait();
+
+    // exit condition
+    if (stop_) {
+      break;
+    }
+
+    execute(workerIndex);
+    finishBarrier_.arriveAndWait();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void WorkerTeam::execute(int workerIndex) {
+  try {
+    taskBody_(taskFunctorPtr_, workerIndex);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(exceptionLock_);
+    if (!failed_) {
+      exception_ = std::current_exception();
+      failed_ = true;
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void WorkerTeam::dispatch(task_body_t body, void* functorPtr) {
+  taskBody_ = body;
+  taskFunctorPtr_ = functorPtr;
+
+  // release the workers, run the task on this thread and wait for the workers to finish
+  startBarrier_.arriveAndWait();
+  execute(static_cast<int>(teamSize_) - 1);
+  finishBarrier_.arriveAndWait();
+
+  taskBody_ = nullptr;
+  taskFunctorPtr_ = nullptr;
+
+  if (failed_) {
+    std::exception_ptr exception;
+    {
+      std::lock_guard<std::mutex> lock(exceptionLock_);
+      exception = std::move(exception_);
+      exception_ = nullptr;
+      failed_ = false;
+    }
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace ocs2
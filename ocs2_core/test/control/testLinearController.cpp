@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include <ocs2_core/control/LinearController.h>
 
 using namespace ocs2;
@@ -24,3 +26,70 @@ TEST(testLinearController, testSerialization) {
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
 }
+
+TEST(testLinearController, testComputeInput) {
+  const scalar_array_t time = {0.0, 1.0, 1.0, 2.0, 3.0};
+  const vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  const matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3),
+                               matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+
+  scalar_array_t queryTimes;
+  vector_array_t queryStates;
+  for (scalar_t t = -0.5; t < 3.5; t += 0.1) {
+    queryTimes.push_back(t);
+    queryStates.push_back(vector_t::Random(3));
+  }
+
+  vector_array_t inputs;
+  controller.computeInputs(queryTimes, queryStates, inputs);
+  ASSERT_EQ(inputs.size(), queryTimes.size());
+
+  vector_t u;
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    // Reference: interpolate the bias and the gain, then evaluate
+    const auto indexAlpha = LinearInterpolation::timeSegment(queryTimes[i], time);
+    const vector_t uExpected =
+        LinearInterpolation::interpolate(indexAlpha, bias) + LinearInterpolation::interpolate(indexAlpha, gain) * queryStates[i];
+
+    controller.computeInput(queryTimes[i], queryStates[i], u);
+    EXPECT_TRUE(u.isApprox(uExpected)) << "t = " << queryTimes[i];
+    EXPECT_TRUE(controller.computeInput(queryTimes[i], queryStates[i]).isApprox(uExpected));
+    EXPECT_TRUE(inputs[i].isApprox(uExpected));
+  }
+}
+
+TEST(testLinearController, testConcurrentComputeInput) {
+  const scalar_array_t time = {0.0, 1.0, 2.0, 3.0};
+  const vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  const matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+  const vector_t x = vector_t::Random(3);
+
+  // Every thread sweeps the horizon in a different direction on the same controller
+  constexpr size_t numThreads = 4;
+  std::vector<int> numErrors(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numThreads; i++) {
+    threads.emplace_back([&, i]() {
+      vector_t u;
+      for (int k = 0; k < 1000; k++) {
+        const scalar_t t = (i % 2 == 0) ? 0.003 * k : 3.0 - 0.003 * k;
+        controller.computeInput(t, x, u);
+        const auto indexAlpha = LinearInterpolation::timeSegment(t, time);
+        const vector_t uExpected =
+            LinearInterpolation::interpolate(indexAlpha, bias) + LinearInterpolation::interpolate(indexAlpha, gain) * x;
+        if (!u.isApprox(uExpected)) {
+          numErrors[i]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < numThreads; i++) {
+    EXPECT_EQ(numErrors[i], 0) << "thread " << i;
+  }
+}
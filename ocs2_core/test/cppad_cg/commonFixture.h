@@ -66,7 +66,9 @@ class CommonCppAdNoParameterFixture : public ::testing::Test {
   void init() {}
 };
 
-class CommonCppAdParameterizedFixture : public ::testing::Test {
+/** The test base class is a parameter, such that fixtures with additional checks (e.g., AllocationFreeTest) can use the model. */
+template <class TestBase = ::testing::Test>
+class CommonCppAdParameterizedFixtureBase : public TestBase {
  public:
   using ad_fun_t = CppAdInterface::ad_fun_t;
   using ad_vector_t = ocs2::ad_vector_t;
@@ -75,12 +77,12 @@ class CommonCppAdParameterizedFixture : public ::testing::Test {
   const size_t rangeDim_ = 2;
   const size_t parameterDim_ = 1;
 
-  CommonCppAdParameterizedFixture() {
+  CommonCppAdParameterizedFixtureBase() {
     create();
     init();
   }
 
-  virtual ~CommonCppAdParameterizedFixture() = default;
+  virtual ~CommonCppAdParameterizedFixtureBase() = default;
 
   void create() {
     // set and declare independent variables and start tape recording
@@ -160,4 +162,6 @@ class CommonCppAdParameterizedFixture : public ::testing::Test {
   cppad_sparsity::SparsityPattern hessianSparsity_;
 };
 
+using CommonCppAdParameterizedFixture = CommonCppAdParameterizedFixtureBase<>;
+
 }  // namespace ocs2
@@ -2,6 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -43,6 +50,158 @@ TEST_F(CppAdInterfaceParameterizedFixture, testModelGeneration) {
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
 
+TEST_F(CppAdInterfaceParameterizedFixture, sparseDerivatives) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelSparseDerivatives");
+
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  vector_t w = vector_t::Random(rangeDim_);
+
+  vector_t nonzeros;
+  adInterface.getSparseJacobian(x, p, nonzeros);
+  matrix_t jacobian = matrix_t::Zero(rangeDim_, variableDim_);
+  cppad_sparsity::addToBlock(adInterface.getJacobianNonzeroIndices(), nonzeros, 0, 0, jacobian);
+  ASSERT_TRUE(jacobian.isApprox(testJacobian(x, p)));
+
+  adInterface.getSparseHessian(w, x, p, nonzeros);
+  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
+  cppad_sparsity::addToSymmetricBlock(adInterface.getHessianNonzeroIndices(), nonzeros, 0, 0, hessian);
+  ASSERT_TRUE(hessian.isApprox(w(0) * testHessian(0, x, p) + w(1) * testHessian(1, x, p)));
+  ASSERT_TRUE(hessian.isApprox(adInterface.getHessian(w, x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, fusedEvaluation) {
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  vector_t w = vector_t::Random(rangeDim_);
+  vector_t value, jacobianNonzeros, hessianNonzeros, separateNonzeros;
+
+  ocs2::CppAdInterface secondOrderAdInterface(funImpl, variableDim_, parameterDim_, "testModelSparseDerivatives");
+  secondOrderAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  secondOrderAdInterface.getValueAndSparseDerivatives(w, x, p, value, jacobianNonzeros, hessianNonzeros);
+  ASSERT_TRUE(value.isApprox(testFun(x, p)));
+  secondOrderAdInterface.getSparseJacobian(x, p, separateNonzeros);
+  ASSERT_TRUE(jacobianNonzeros.isApprox(separateNonzeros));
+  secondOrderAdInterface.getSparseHessian(w, x, p, separateNonzeros);
+  ASSERT_TRUE(hessianNonzeros.isApprox(separateNonzeros));
+
+  ocs2::CppAdInterface firstOrderAdInterface(funImpl, variableDim_, parameterDim_, "testModelFusedFirstOrder");
+  firstOrderAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, true);
+  firstOrderAdInterface.getValueAndSparseJacobian(x, p, value, jacobianNonzeros);
+  ASSERT_TRUE(value.isApprox(testFun(x, p)));
+  firstOrderAdInterface.getSparseJacobian(x, p, separateNonzeros);
+  ASSERT_TRUE(jacobianNonzeros.isApprox(separateNonzeros));
+
+  // Second order libraries also have the fused function without the Hessian
+  secondOrderAdInterface.getValueAndSparseJacobian(x, p, value, jacobianNonzeros);
+  ASSERT_TRUE(value.isApprox(testFun(x, p)));
+  secondOrderAdInterface.getSparseJacobian(x, p, separateNonzeros);
+  ASSERT_TRUE(jacobianNonzeros.isApprox(separateNonzeros));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, batchedEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelSparseDerivatives");
+
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  const size_t numPoints = 5;
+  matrix_t x = matrix_t::Random(variableDim_, numPoints);
+  matrix_t p = matrix_t::Random(parameterDim_, numPoints);
+
+  matrix_t values;
+  matrix_t jacobianNonzeros;
+  adInterface.getFunctionValues(x, p, values);
+  adInterface.getSparseJacobians(x, p, jacobianNonzeros);
+  ASSERT_EQ(values.cols(), numPoints);
+  ASSERT_EQ(jacobianNonzeros.cols(), numPoints);
+
+  for (size_t i = 0; i < numPoints; i++) {
+    ASSERT_TRUE(values.col(i).isApprox(testFun(x.col(i), p.col(i))));
+    matrix_t jacobian = matrix_t::Zero(rangeDim_, variableDim_);
+    cppad_sparsity::addToBlock(adInterface.getJacobianNonzeroIndices(), jacobianNonzeros.col(i), 0, 0, jacobian);
+    ASSERT_TRUE(jacobian.isApprox(testJacobian(x.col(i), p.col(i))));
+  }
+
+  ASSERT_ANY_THROW(adInterface.getFunctionValues(x, p.leftCols(numPoints - 1), values));
+}
+
+TEST_F(CppAdInterfaceNoParameterFixture, batchedEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, "testModelWithoutParameters");
+
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  matrix_t x = matrix_t::Random(variableDim_, 3);
+
+  matrix_t values;
+  matrix_t jacobianNonzeros;
+  adInterface.getFunctionValues(x, matrix_t(), values);
+  adInterface.getSparseJacobians(x, matrix_t(), jacobianNonzeros);
+  for (int i = 0; i < x.cols(); i++) {
+    ASSERT_TRUE(values.col(i).isApprox(testFun(x.col(i))));
+    vector_t nonzeros;
+    adInterface.getSparseJacobian(x.col(i), vector_t(0), nonzeros);
+    ASSERT_TRUE(jacobianNonzeros.col(i).isApprox(nonzeros));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, singlePrecision) {
+  ocs2::CppAdInterface doubleAdInterface(funImpl, variableDim_, parameterDim_, "testModelSparseDerivatives");
+  doubleAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ocs2::CppAdInterface floatAdInterface(funImpl, variableDim_, parameterDim_, "testModelSinglePrecision");
+  floatAdInterface.setSinglePrecision(true);
+  floatAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_FALSE(doubleAdInterface.isSinglePrecision());
+  ASSERT_TRUE(floatAdInterface.isSinglePrecision());
+
+  // Relative to the magnitude of the double precision result
+  const scalar_t tolerance = 1e-5;
+  auto isClose = [&](const matrix_t& singlePrecisionResult, const matrix_t& doublePrecisionResult) {
+    return (singlePrecisionResult - doublePrecisionResult).norm() <= tolerance * (1.0 + doublePrecisionResult.norm());
+  };
+
+  for (int i = 0; i < 10; i++) {
+    const vector_t x = 10.0 * vector_t::Random(variableDim_);
+    const vector_t p = vector_t::Random(parameterDim_);
+    ASSERT_TRUE(isClose(floatAdInterface.getFunctionValue(x, p), doubleAdInterface.getFunctionValue(x, p)));
+    ASSERT_TRUE(isClose(floatAdInterface.getJacobian(x, p), doubleAdInterface.getJacobian(x, p)));
+    const auto floatGnApproximation = floatAdInterface.getGaussNewtonApproximation(x, p);
+    const auto doubleGnApproximation = doubleAdInterface.getGaussNewtonApproximation(x, p);
+    ASSERT_TRUE(isClose(floatGnApproximation.dfdx, doubleGnApproximation.dfdx));
+    ASSERT_TRUE(isClose(floatGnApproximation.dfdxx, doubleGnApproximation.dfdxx));
+    // The Hessian is evaluated in double precision
+    ASSERT_TRUE(floatAdInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  }
+
+  const size_t numPoints = 5;
+  const matrix_t x = matrix_t::Random(variableDim_, numPoints);
+  const matrix_t p = matrix_t::Random(parameterDim_, numPoints);
+  matrix_t floatResult, doubleResult;
+  floatAdInterface.getFunctionValues(x, p, floatResult);
+  doubleAdInterface.getFunctionValues(x, p, doubleResult);
+  ASSERT_TRUE(isClose(floatResult, doubleResult));
+  floatAdInterface.getSparseJacobians(x, p, floatResult);
+  doubleAdInterface.getSparseJacobians(x, p, doubleResult);
+  ASSERT_TRUE(isClose(floatResult, doubleResult));
+
+  // Copies evaluate in single precision as well
+  ocs2::CppAdInterface copiedAdInterface(floatAdInterface);
+  ASSERT_TRUE(copiedAdInterface.isSinglePrecision());
+}
+
+TEST_F(CppAdInterfaceNoParameterFixture, singlePrecision) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, "testModelSinglePrecisionWithoutParameters");
+  adInterface.setSinglePrecision(true);
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, true);
+  ASSERT_TRUE(adInterface.isSinglePrecision());
+
+  matrix_t x = matrix_t::Random(variableDim_, 3);
+  matrix_t values;
+  adInterface.getFunctionValues(x, matrix_t(), values);
+  for (int i = 0; i < x.cols(); i++) {
+    ASSERT_TRUE(values.col(i).isApprox(testFun(x.col(i)), 1e-5));
+    ASSERT_TRUE(adInterface.getJacobian(x.col(i)).isApprox(testJacobian(x.col(i)), 1e-5));
+  }
+}
+
 TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfAvailable");
 
@@ -60,3 +219,144 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, createModelsAsync) {
+  constexpr size_t numModels = 4;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  for (size_t i = 0; i < numModels; ++i) {
+    adInterfaces.emplace_back(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelAsync" + std::to_string(i)));
+    adInterfaces.back()->createModelsAsync(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  }
+  std::vector<const ocs2::CppAdInterface*> interfacePtrs;
+  for (const auto& adInterfacePtr : adInterfaces) {
+    interfacePtrs.push_back(adInterfacePtr.get());
+  }
+  ocs2::CppAdInterface::waitForModels(interfacePtrs);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  for (const auto& adInterfacePtr : adInterfaces) {
+    ASSERT_TRUE(adInterfacePtr->getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_TRUE(adInterfacePtr->getJacobian(x, p).isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(adInterfacePtr->getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+    ASSERT_TRUE(adInterfacePtr->getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, copyWaitsForAsyncModels) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelCopyAsync");
+  adInterface.createModelsAsync(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  const ocs2::CppAdInterface adInterfaceCopy(adInterface);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(adInterfaceCopy.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterfaceCopy.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, deferredWait) {
+  constexpr size_t numModels = 2;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  ocs2::CppAdDeferredWait deferredWait;
+  for (size_t i = 0; i < numModels; ++i) {
+    // The model function refers to a local which is out of scope once the models are compiled
+    const scalar_t scaling = i + 1.0;
+    auto scaledFunImpl = [&scaling](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+      funImpl(x, p, y);
+      y *= ad_scalar_t(scaling);
+    };
+    const std::string modelName = "testModelDeferred" + std::to_string(i);
+    adInterfaces.emplace_back(new ocs2::CppAdInterface(scaledFunImpl, variableDim_, parameterDim_, modelName));
+    adInterfaces.back()->createModelsAsync(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+    // Returns immediately
+    ocs2::CppAdInterface::waitForModels({adInterfaces.back().get()});
+  }
+  deferredWait.waitAll();
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  for (size_t i = 0; i < numModels; ++i) {
+    ASSERT_TRUE(adInterfaces[i]->getFunctionValue(x, p).isApprox((i + 1.0) * testFun(x, p)));
+    ASSERT_TRUE(adInterfaces[i]->getJacobian(x, p).isApprox((i + 1.0) * testJacobian(x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceNoParameterFixture, loadIfAvailableDetectsChangedModel) {
+  const std::string modelName = "testModelCache";
+  boost::filesystem::remove_all("/tmp/ocs2/" + modelName);
+  auto scaledFunImpl = [](const ad_vector_t& x, ad_vector_t& y) {
+    funImpl(x, y);
+    y(0) *= 3.0;
+  };
+  vector_t x = vector_t::Random(variableDim_);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, modelName);
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_TRUE(adInterface.getFunctionValue(x).isApprox(testFun(x)));
+
+  // Same model name, but a different operation graph
+  ocs2::CppAdInterface scaledAdInterface(scaledFunImpl, variableDim_, modelName);
+  scaledAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_TRUE(scaledAdInterface.getFunctionValue(x).isApprox(3.0 * testFun(x)));
+  ASSERT_TRUE(scaledAdInterface.getJacobian(x).isApprox(3.0 * testJacobian(x)));
+
+  // Same model, but a different approximation order
+  ocs2::CppAdInterface firstOrderAdInterface(funImpl, variableDim_, modelName);
+  firstOrderAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, true);
+  ASSERT_TRUE(firstOrderAdInterface.getJacobian(x).isApprox(testJacobian(x)));
+
+  // The original model is loaded from the cache
+  const auto indexFile = "/tmp/ocs2/" + modelName + "/cppad_generated/" + modelName + "_lib_index";
+  const auto indexModificationTime = boost::filesystem::last_write_time(indexFile);
+  ocs2::CppAdInterface cachedAdInterface(funImpl, variableDim_, modelName);
+  cachedAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_TRUE(cachedAdInterface.getFunctionValue(x).isApprox(testFun(x)));
+  ASSERT_TRUE(cachedAdInterface.getHessian(0, x).isApprox(testHessian(x)));
+  ASSERT_EQ(boost::filesystem::last_write_time(indexFile), indexModificationTime);
+
+  std::ifstream index(indexFile);
+  const auto numEntries = std::count(std::istreambuf_iterator<char>(index), std::istreambuf_iterator<char>(), '\n');
+  ASSERT_EQ(numEntries, 3);
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, clonesShareLibrary) {
+  const std::string modelName = "testModelSharedLibrary";
+  const std::string libraryFile = "/tmp/ocs2/" + modelName + "/cppad_generated/" + modelName + "_lib.so";
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, modelName));
+  adInterfacePtr->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  // The unkeyed library name resolves to the loaded library
+  const auto library = ocs2::CppAdModelLibrary::load(libraryFile, modelName);
+  ASSERT_EQ(library, ocs2::CppAdModelLibrary::load(libraryFile, modelName));
+  ASSERT_EQ(&library->getJacobianNonzeroIndices(), &adInterfacePtr->getJacobianNonzeroIndices());
+
+  // Clones evaluate concurrently with their own models
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> clones;
+  for (int i = 0; i < 4; i++) {
+    clones.emplace_back(new ocs2::CppAdInterface(*adInterfacePtr));
+    ASSERT_EQ(&library->getHessianNonzeroIndices(), &clones.back()->getHessianNonzeroIndices());
+  }
+  adInterfacePtr.reset();
+
+  std::vector<std::thread> threads;
+  std::vector<int> success(clones.size(), 0);
+  for (size_t i = 0; i < clones.size(); i++) {
+    threads.emplace_back([&, i]() {
+      bool allCorrect = true;
+      for (int j = 0; j < 100; j++) {
+        const vector_t x = vector_t::Random(variableDim_);
+        const vector_t p = vector_t::Random(parameterDim_);
+        allCorrect = allCorrect && clones[i]->getFunctionValue(x, p).isApprox(testFun(x, p));
+        allCorrect = allCorrect && clones[i]->getJacobian(x, p).isApprox(testJacobian(x, p));
+      }
+      clones[i].reset();
+      success[i] = allCorrect ? 1 : 0;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto s : success) {
+    ASSERT_EQ(s, 1);
+  }
+}
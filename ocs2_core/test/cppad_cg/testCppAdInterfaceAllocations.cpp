@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/test/AllocationFreeTest.h>
+
+#include "commonFixture.h"
+
+using namespace ocs2;
+
+class CppAdInterfaceAllocationFixture : public CommonCppAdParameterizedFixtureBase<AllocationFreeTest> {
+ protected:
+  void checkEvaluations(const CppAdInterface& adInterface) {
+    const vector_t x = vector_t::Random(variableDim_);
+    const vector_t p = vector_t::Random(parameterDim_);
+    const vector_t w = vector_t::Random(rangeDim_);
+    vector_t value, jacobianNonzeros, hessianNonzeros;
+    matrix_t jacobian;
+    ScalarFunctionQuadraticApproximation gnApproximation;
+
+    EXPECT_ALLOCATION_FREE(adInterface.getFunctionValue(x, p, value));
+    EXPECT_ALLOCATION_FREE(adInterface.getJacobian(x, p, jacobian));
+    EXPECT_ALLOCATION_FREE(adInterface.getSparseJacobian(x, p, jacobianNonzeros));
+    EXPECT_ALLOCATION_FREE(adInterface.getValueAndSparseJacobian(x, p, value, jacobianNonzeros));
+    EXPECT_ALLOCATION_FREE(adInterface.getGaussNewtonApproximation(x, p, gnApproximation));
+    if (!adInterface.isSinglePrecision()) {
+      EXPECT_ALLOCATION_FREE(adInterface.getSparseHessian(w, x, p, hessianNonzeros));
+      EXPECT_ALLOCATION_FREE(adInterface.getValueAndSparseDerivatives(w, x, p, value, jacobianNonzeros, hessianNonzeros));
+    }
+
+    const size_t numPoints = 5;
+    const matrix_t xs = matrix_t::Random(variableDim_, numPoints);
+    const matrix_t ps = matrix_t::Random(parameterDim_, numPoints);
+    matrix_t values, jacobiansNonzeros;
+    EXPECT_ALLOCATION_FREE(adInterface.getFunctionValues(xs, ps, values));
+    EXPECT_ALLOCATION_FREE(adInterface.getSparseJacobians(xs, ps, jacobiansNonzeros));
+
+    // Results are unaffected by the reuse of the buffers
+    adInterface.getFunctionValue(x, p, value);
+    adInterface.getJacobian(x, p, jacobian);
+    const double tolerance = adInterface.isSinglePrecision() ? 1e-5 : 1e-12;
+    ASSERT_TRUE(value.isApprox(testFun(x, p), tolerance));
+    ASSERT_TRUE(jacobian.isApprox(testJacobian(x, p), tolerance));
+  }
+};
+
+TEST_F(CppAdInterfaceAllocationFixture, doublePrecision) {
+  CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelAllocations");
+  adInterface.loadModelsIfAvailable(CppAdInterface::ApproximationOrder::Second, true);
+  checkEvaluations(adInterface);
+}
+
+TEST_F(CppAdInterfaceAllocationFixture, singlePrecision) {
+  CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelAllocationsFloat");
+  adInterface.setSinglePrecision(true);
+  adInterface.loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, true);
+  ASSERT_TRUE(adInterface.isSinglePrecision());
+  checkEvaluations(adInterface);
+}
+
+TEST_F(CppAdInterfaceAllocationFixture, clones) {
+  CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelAllocations");
+  adInterface.loadModelsIfAvailable(CppAdInterface::ApproximationOrder::Second, true);
+  const CppAdInterface clone(adInterface);
+  checkEvaluations(clone);
+}
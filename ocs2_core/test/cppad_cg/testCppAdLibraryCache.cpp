@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/automatic_differentiation/CppAdLibraryCache.h>
+
+using namespace ocs2;
+
+TEST(testCppAdLibraryCache, hash) {
+  using cppad_library_cache::Hash;
+  // FNV-1a reference value of the empty input
+  ASSERT_EQ(Hash().toString(), "cbf29ce484222325");
+  ASSERT_EQ(Hash().add("model").add(3).toString(), Hash().add("model").add(3).toString());
+  ASSERT_NE(Hash().add("model").add(3).toString(), Hash().add("model").add(4).toString());
+  // Fields are length-prefixed, concatenations do not collide
+  ASSERT_NE(Hash().add("ab").add("c").toString(), Hash().add("a").add("bc").toString());
+}
+
+TEST(testCppAdLibraryCache, operationGraph) {
+  auto tape = [](double factor) {
+    ad_vector_t x(2);
+    x.setOnes();
+    CppAD::Independent(x);
+    ad_vector_t y(1);
+    y(0) = factor * x(0) * x(1);
+    std::unique_ptr<CppAD::ADFun<ad_base_t>> funPtr(new CppAD::ADFun<ad_base_t>(x, y));
+    return cppad_library_cache::getOperationGraph(*funPtr);
+  };
+  ASSERT_EQ(tape(2.0), tape(2.0));
+  ASSERT_NE(tape(2.0), tape(2.0 + 1e-12));
+}
+
+TEST(testCppAdLibraryCache, concurrentIndexWriters) {
+  const std::string folder = "/tmp/ocs2/testCppAdLibraryCache";
+  boost::filesystem::remove_all(folder);
+  boost::filesystem::create_directories(folder);
+  const std::string indexFile = folder + "/index";
+
+  constexpr int numThreads = 4;
+  constexpr int numKeysPerThread = 25;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int k = 0; k < numKeysPerThread; ++k) {
+        const std::string key = std::to_string(t) + "_" + std::to_string(k);
+        cppad_library_cache::addLibrary(indexFile, key, "lib_" + key + ".so", "test entry");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int t = 0; t < numThreads; ++t) {
+    for (int k = 0; k < numKeysPerThread; ++k) {
+      const std::string key = std::to_string(t) + "_" + std::to_string(k);
+      ASSERT_EQ(cppad_library_cache::findLibrary(indexFile, key), "lib_" + key + ".so");
+    }
+  }
+  ASSERT_TRUE(cppad_library_cache::findLibrary(indexFile, "unknown").empty());
+
+  // Replacing an entry
+  cppad_library_cache::addLibrary(indexFile, "0_0", "lib_replaced.so", "test entry");
+  ASSERT_EQ(cppad_library_cache::findLibrary(indexFile, "0_0"), "lib_replaced.so");
+}
@@ -0,0 +1,48 @@
+
+
+#include <gtest/gtest.h>
+
+#include <ocs2_cppad_prelinked/testPrelinkedModel.h>
+
+#include "commonFixture.h"
+
+using namespace ocs2;
+
+class CppAdPrelinkedModelFixture : public CommonCppAdParameterizedFixture {};
+
+TEST_F(CppAdPrelinkedModelFixture, evaluation) {
+  const auto& prelinkedModel = ocs2::cppad_prelinked::testPrelinkedModel();
+  ASSERT_EQ(prelinkedModel.variableDim, variableDim_);
+  ASSERT_EQ(prelinkedModel.parameterDim, parameterDim_);
+
+  ocs2::CppAdInterface adInterface(prelinkedModel);
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  vector_t w = vector_t::Random(rangeDim_);
+
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+  ASSERT_TRUE(adInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  ASSERT_TRUE(adInterface.getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+
+  // The fused model is prelinked as well
+  vector_t value, jacobianNonzeros, hessianNonzeros, separateNonzeros;
+  adInterface.getValueAndSparseDerivatives(w, x, p, value, jacobianNonzeros, hessianNonzeros);
+  ASSERT_TRUE(value.isApprox(testFun(x, p)));
+  adInterface.getSparseJacobian(x, p, separateNonzeros);
+  ASSERT_TRUE(jacobianNonzeros.isApprox(separateNonzeros));
+  adInterface.getSparseHessian(w, x, p, separateNonzeros);
+  ASSERT_TRUE(hessianNonzeros.isApprox(separateNonzeros));
+}
+
+TEST_F(CppAdPrelinkedModelFixture, clonesShareLibrary) {
+  ocs2::CppAdInterface adInterface(ocs2::cppad_prelinked::testPrelinkedModel());
+  ocs2::CppAdInterface otherAdInterface(ocs2::cppad_prelinked::testPrelinkedModel());
+  ocs2::CppAdInterface clonedAdInterface(adInterface);
+  ASSERT_EQ(&adInterface.getJacobianNonzeroIndices(), &otherAdInterface.getJacobianNonzeroIndices());
+  ASSERT_EQ(&adInterface.getJacobianNonzeroIndices(), &clonedAdInterface.getJacobianNonzeroIndices());
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(clonedAdInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
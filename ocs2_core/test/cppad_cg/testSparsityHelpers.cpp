@@ -47,3 +47,37 @@ TEST(CppAdSparsity, hessianSparsity) {
   cppad_sparsity::SparsityPattern trueSparsityDiagonal{{0, 1}, {1}, {}};
   ASSERT_EQ(sparsityDiagonal, trueSparsityDiagonal);
 }
+
+TEST(CppAdSparsity, addToBlock) {
+  // J = [1 0 2; 0 3 4]
+  cppad_sparsity::NonzeroIndices indices{{0, 0, 1, 1}, {0, 2, 1, 2}};
+  vector_t nonzeros(4);
+  nonzeros << 1.0, 2.0, 3.0, 4.0;
+
+  matrix_t block = matrix_t::Ones(2, 2);
+  cppad_sparsity::addToBlock(indices, nonzeros, 0, 1, block);
+  matrix_t trueBlock(2, 2);
+  trueBlock << 1.0, 3.0, 4.0, 5.0;
+  ASSERT_TRUE(block.isApprox(trueBlock));
+
+  vector_t gradient = vector_t::Zero(2);
+  cppad_sparsity::addToBlockTransposed(indices, nonzeros, 1, 1, gradient);
+  ASSERT_TRUE(gradient.isApprox((vector_t(2) << 3.0, 4.0).finished()));
+}
+
+TEST(CppAdSparsity, addToSymmetricBlock) {
+  // Upper triangular part of H = [1 2 3; 2 4 5; 3 5 6]
+  cppad_sparsity::NonzeroIndices indices{{0, 0, 0, 1, 1, 2}, {0, 1, 2, 1, 2, 2}};
+  vector_t nonzeros(6);
+  nonzeros << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+  matrix_t hessian(3, 3);
+  hessian << 1.0, 2.0, 3.0, 2.0, 4.0, 5.0, 3.0, 5.0, 6.0;
+
+  for (size_t rowOffset = 0; rowOffset < 3; rowOffset++) {
+    for (size_t colOffset = 0; colOffset < 3; colOffset++) {
+      matrix_t block = matrix_t::Zero(3 - rowOffset, 3 - colOffset);
+      cppad_sparsity::addToSymmetricBlock(indices, nonzeros, rowOffset, colOffset, block);
+      ASSERT_TRUE(block.isApprox(hessian.bottomRightCorner(3 - rowOffset, 3 - colOffset)));
+    }
+  }
+}
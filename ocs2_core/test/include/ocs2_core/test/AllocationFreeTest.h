@@ -0,0 +1,73 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/AllocationCounter.h>
+
+namespace ocs2 {
+
+/**
+ * Counts the heap allocations of the repeated calls of a function. The function is called once before counting such that
+ * buffers that are lazily allocated on the first call do not count. The test executable has to be linked against
+ * ocs2_core_allocation_hooks.
+ *
+ * @param [in] f: The function to be measured.
+ * @param [in] numRepetitions: Number of measured calls.
+ * @return The number of allocations of the measured calls.
+ */
+template <typename Function>
+size_t countSteadyStateAllocations(Function&& f, size_t numRepetitions = 10) {
+  f();
+  const auto start = benchmark::getAllocationStatistics();
+  for (size_t i = 0; i < numRepetitions; i++) {
+    f();
+  }
+  return benchmark::getAllocationStatistics().numAllocations - start.numAllocations;
+}
+
+/**
+ * Test fixture for steady-state regions that must not allocate. Fails if the allocation hooks are not linked in, since the
+ * checks would pass trivially otherwise.
+ */
+class AllocationFreeTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(benchmark::isAllocationCounterInstalled()) << "Link the test against ocs2_core_allocation_hooks.";
+  }
+};
+
+}  // namespace ocs2
+
+/** Expects that the statement does not allocate once it has been executed before. */
+#define EXPECT_ALLOCATION_FREE(statement)                                             \
+  EXPECT_EQ(::ocs2::countSteadyStateAllocations([&]() { statement; }), size_t(0)) \
+      << "The steady-state region allocates: " #statement
@@ -0,0 +1,154 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/AllocationCounter.h>
+#include <ocs2_core/misc/ContiguousTrajectory.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/test/AllocationFreeTest.h>
+
+using namespace ocs2;
+
+TEST(testAllocationCounter, countsHeapAllocations) {
+  ASSERT_TRUE(benchmark::isAllocationCounterInstalled());
+
+#if defined(__GLIBC__)
+  constexpr size_t numMallocs = 1;
+#else
+  // Only operator new is hooked, the malloc of Eigen is not counted
+  constexpr size_t numMallocs = 0;
+#endif
+
+  benchmark::RepeatedAllocationCounter counter;
+  // Eigen allocates with malloc
+  counter.startCounter();
+  vector_t v = vector_t::Random(100);
+  counter.endCounter();
+  ASSERT_EQ(counter.getLastInterval().numAllocations, numMallocs);
+#if defined(__GLIBC__)
+  ASSERT_GE(counter.getLastInterval().numBytes, 100 * sizeof(scalar_t));
+#endif
+
+  // operator new for the matrix object, malloc for its data
+  counter.startCounter();
+  auto p = std::make_unique<matrix_t>(10, 10);
+  counter.endCounter();
+  ASSERT_EQ(counter.getLastInterval().numAllocations, 1 + numMallocs);
+
+  // No allocation
+  counter.startCounter();
+  v.setZero();
+  counter.endCounter();
+  ASSERT_EQ(counter.getLastInterval().numAllocations, 0);
+
+  ASSERT_EQ(counter.getNumMeasuredIntervals(), 3);
+  ASSERT_EQ(counter.getTotal().numAllocations, 1 + 2 * numMallocs);
+  ASSERT_EQ(counter.getMaxIntervalAllocations(), 1 + numMallocs);
+  ASSERT_DOUBLE_EQ(counter.getAverageAllocations(), (1.0 + 2.0 * numMallocs) / 3.0);
+
+  counter.reset();
+  ASSERT_EQ(counter.getNumMeasuredIntervals(), 0);
+  ASSERT_EQ(counter.getTotal().numAllocations, 0);
+}
+
+#if defined(__GLIBC__)
+TEST(testAllocationCounter, posixMemalignValidatesAlignment) {
+  int marker = 0;
+  void* const sentinel = &marker;
+  for (const size_t alignment : {size_t(0), size_t(3), sizeof(void*) / 2, 3 * sizeof(void*)}) {
+    void* ptr = sentinel;
+    ASSERT_EQ(posix_memalign(&ptr, alignment, 64), EINVAL) << "alignment: " << alignment;
+    ASSERT_EQ(ptr, sentinel);
+  }
+
+  void* ptr = nullptr;
+  ASSERT_EQ(posix_memalign(&ptr, 64, 64), 0);
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+  std::free(ptr);
+}
+#endif
+
+class ContiguousTrajectoryAllocations : public AllocationFreeTest {};
+
+TEST_F(ContiguousTrajectoryAllocations, steadyState) {
+  const vector_array_t reference{vector_t::Random(3), vector_t::Random(2), vector_t::Random(3)};
+  ContiguousTrajectory trajectory(reference);
+  ContiguousTrajectory increment(reference);
+  vector_array_t output;
+
+  EXPECT_ALLOCATION_FREE(trajectory.assign(reference));
+  EXPECT_ALLOCATION_FREE(trajectory.toVectorArray(output));
+  EXPECT_ALLOCATION_FREE(trajectory.flat() += 0.1 * increment.flat());
+  EXPECT_ALLOCATION_FREE(trajectory.swap(increment));
+  const std::vector<int> smallerSizes{2, 3, 1};
+  EXPECT_ALLOCATION_FREE(trajectory.resize(smallerSizes));
+
+  // The check detects allocations: the size of output[0] alternates, which reallocates it on every call
+  size_t k = 0;
+  EXPECT_EQ(countSteadyStateAllocations([&]() { output[0].setZero(3 + (k++ % 2)); }, 10), 10);
+}
+
+class LinearControllerAllocations : public AllocationFreeTest {};
+
+TEST_F(LinearControllerAllocations, computeInput) {
+  const scalar_array_t time{0.0, 1.0, 2.0};
+  const vector_array_t bias(3, vector_t::Random(4));
+  const matrix_array_t gain(3, matrix_t::Random(4, 12));
+  LinearController controller(time, bias, gain);
+
+  const vector_t x = vector_t::Random(12);
+  vector_t u(4);
+  scalar_t t = 0.0;
+  EXPECT_ALLOCATION_FREE(controller.computeInput(t += 0.01, x, u));
+
+  const scalar_array_t timeTrajectory{0.1, 0.5, 1.5};
+  const vector_array_t stateTrajectory(3, x);
+  vector_array_t inputTrajectory;
+  EXPECT_ALLOCATION_FREE(controller.computeInputs(timeTrajectory, stateTrajectory, inputTrajectory));
+}
+
+class LinearInterpolationAllocations : public AllocationFreeTest {};
+
+TEST_F(LinearInterpolationAllocations, interpolate) {
+  const scalar_array_t time{0.0, 1.0, 2.0};
+  const vector_array_t data(3, vector_t::Random(12));
+
+  vector_t result(12);
+  scalar_t t = 0.0;
+  EXPECT_ALLOCATION_FREE(LinearInterpolation::interpolate(t += 0.01, time, data, result));
+}
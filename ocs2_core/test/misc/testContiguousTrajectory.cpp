@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/ContiguousTrajectory.h>
+
+using namespace ocs2;
+
+namespace {
+vector_array_t getRandomTrajectory(const std::vector<int>& sizes) {
+  vector_array_t trajectory;
+  for (const auto n : sizes) {
+    trajectory.push_back(vector_t::Random(n));
+  }
+  return trajectory;
+}
+}  // unnamed namespace
+
+TEST(testContiguousTrajectory, layout) {
+  const std::vector<int> sizes{3, 0, 5, 2};
+  ContiguousTrajectory trajectory(sizes);
+
+  ASSERT_EQ(trajectory.size(), sizes.size());
+  ASSERT_EQ(trajectory.stride(), 5);
+  ASSERT_EQ(trajectory.flat().size(), 5 * sizes.size());
+  for (size_t i = 0; i < sizes.size(); i++) {
+    ASSERT_EQ(trajectory[i].size(), sizes[i]);
+    ASSERT_EQ(trajectory[i].data(), trajectory.flat().data() + i * trajectory.stride());
+    ASSERT_TRUE(trajectory[i].isZero());
+  }
+}
+
+TEST(testContiguousTrajectory, conversion) {
+  const vector_array_t reference = getRandomTrajectory({3, 0, 5, 2});
+  const ContiguousTrajectory trajectory(reference);
+
+  for (size_t i = 0; i < reference.size(); i++) {
+    ASSERT_TRUE(trajectory[i].isApprox(reference[i]));
+  }
+  ASSERT_EQ(trajectory.toVectorArray(), reference);
+
+  // The padding stays at zero, so the flat buffer has the same norm as the trajectory
+  scalar_t squaredNorm = 0.0;
+  for (const auto& v : reference) {
+    squaredNorm += v.squaredNorm();
+  }
+  ASSERT_NEAR(trajectory.flat().squaredNorm(), squaredNorm, 1e-12);
+}
+
+TEST(testContiguousTrajectory, resizeKeepsBuffer) {
+  ContiguousTrajectory trajectory(getRandomTrajectory({4, 4, 4}));
+  const scalar_t* data = trajectory.flat().data();
+
+  // A smaller layout fits in the existing buffer
+  trajectory.resize({2, 3});
+  ASSERT_EQ(trajectory.flat().data(), data);
+  ASSERT_TRUE(trajectory.flat().isZero());
+
+  // Assigning a trajectory with the same layout only copies
+  const vector_array_t reference = getRandomTrajectory({2, 3});
+  trajectory.assign(reference);
+  ASSERT_EQ(trajectory.flat().data(), data);
+  ASSERT_EQ(trajectory.toVectorArray(), reference);
+}
+
+TEST(testContiguousTrajectory, swap) {
+  const vector_array_t reference1 = getRandomTrajectory({2, 3});
+  const vector_array_t reference2 = getRandomTrajectory({1, 1, 1});
+  ContiguousTrajectory trajectory1(reference1);
+  ContiguousTrajectory trajectory2(reference2);
+
+  swap(trajectory1, trajectory2);
+  ASSERT_EQ(trajectory1.toVectorArray(), reference2);
+  ASSERT_EQ(trajectory2.toVectorArray(), reference1);
+  ASSERT_FALSE(trajectory1.hasSameLayout(trajectory2));
+}
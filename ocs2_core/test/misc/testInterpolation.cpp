@@ -132,3 +132,46 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testTimeSegmentCursor) {
+  const std::vector<double> times = {0.0, 0.5, 1.0, 1.0, 1.5, 2.0, 3.0};
+  ocs2::LinearInterpolation::TimeSegmentCursor cursor;
+
+  auto expectSameSegment = [&](double t) {
+    const auto expected = ocs2::LinearInterpolation::timeSegment(t, times);
+    const auto result = cursor.timeSegment(t, times);
+    EXPECT_EQ(result.first, expected.first) << "t = " << t;
+    EXPECT_DOUBLE_EQ(result.second, expected.second) << "t = " << t;
+  };
+
+  // Sequential queries
+  for (double t = -0.5; t <= 3.5; t += 0.05) {
+    expectSameSegment(t);
+  }
+  // Jumps
+  for (double t : {2.5, 0.1, 1.0, 3.0, -1.0, 1.2}) {
+    expectSameSegment(t);
+  }
+
+  // The cursor stays valid if the time array changes
+  const std::vector<double> shortTimes = {0.0, 1.0};
+  const auto result = cursor.timeSegment(0.25, shortTimes);
+  EXPECT_EQ(result.first, 0);
+  EXPECT_DOUBLE_EQ(result.second, 0.75);
+}
+
+TEST(testLinearInterpolation, testOutputArgument) {
+  const std::vector<double> times = {0.0, 1.0, 2.0};
+  const ocs2::vector_array_t data = {ocs2::vector_t::Random(3), ocs2::vector_t::Random(3), ocs2::vector_t::Random(2)};
+
+  ocs2::vector_t result;
+  for (double t : {-0.5, 0.0, 0.3, 1.0, 1.4, 1.6, 2.5}) {
+    ocs2::LinearInterpolation::interpolate(t, times, data, result);
+    EXPECT_TRUE(result.isApprox(ocs2::LinearInterpolation::interpolate(t, times, data))) << "t = " << t;
+  }
+
+  const std::vector<double> singleTime = {1.0};
+  const ocs2::vector_array_t singleData = {ocs2::vector_t::Random(2)};
+  ocs2::LinearInterpolation::interpolate(0.0, singleTime, singleData, result);
+  EXPECT_TRUE(result.isApprox(singleData.front()));
+}
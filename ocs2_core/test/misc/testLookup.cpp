@@ -74,6 +74,31 @@ TEST(testLookup, findIndexInTimeArray_precision_highNumbers) {
   ASSERT_EQ(findIndexInTimeArray(timeArray, tQueryPlus), 1);
 }
 
+TEST(testLookup, findIndexInTimeArray_hint) {
+  const std::vector<double> timeArray{-1.0, 0.0, 0.5, 0.5, 0.5, 1.0, 2.0, 3.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+
+  // Monotonic queries, including the times of the array and the duplicates
+  int hint = 0;
+  for (double t = -2.0; t <= 8.0; t += 0.125) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, t, hint), findIndexInTimeArray(timeArray, t)) << "t = " << t;
+    ASSERT_EQ(hint, findIndexInTimeArray(timeArray, t));
+  }
+
+  // Jumps in both directions and invalid hints
+  const std::vector<double> queries{7.5, -3.0, 0.5, 6.5, 3.0, 2.9, 0.5, 0.49, 8.0, 3.0};
+  for (const auto t : queries) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, t, hint), findIndexInTimeArray(timeArray, t)) << "t = " << t;
+  }
+  for (int invalidHint : {-5, 100}) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, 2.5, invalidHint), findIndexInTimeArray(timeArray, 2.5));
+  }
+
+  // empty time
+  const std::vector<double> timeArrayEmpty;
+  hint = 3;
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0, hint), 0);
+}
+
 TEST(testLookup, findIntervalInTimeArray) {
   // Normal case
   std::vector<double> timeArray{-1.0, 2.0, 3.0};
@@ -121,3 +121,87 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testRunParallelRethrows) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+
+  auto task = [&](int) {
+    if (counter++ == 1) {
+      throw std::runtime_error("task exception");
+    }
+  };
+  EXPECT_THROW(pool.runParallel(task, 3), std::runtime_error);
+  EXPECT_EQ(counter, 3);
+
+  // The pool is still usable afterwards
+  counter = 0;
+  pool.runParallel([&](int) { counter++; }, 5);
+  EXPECT_EQ(counter, 5);
+}
+
+TEST(testThreadPool, testParallelFor) {
+  constexpr int begin = 3;
+  constexpr int end = 1003;
+
+  for (size_t nThreads : {0, 1, 3}) {
+    ThreadPool pool(nThreads);
+    for (int grain : {1, 7, 2000}) {
+      std::vector<std::atomic_int> visits(end);
+      std::vector<int> workerIndices(end, -1);
+      pool.parallelFor(begin, end, grain, [&](int workerIndex, int i) {
+        visits[i]++;
+        workerIndices[i] = workerIndex;
+      });
+
+      for (int i = 0; i < end; ++i) {
+        EXPECT_EQ(visits[i], (i < begin) ? 0 : 1);
+        if (i >= begin) {
+          EXPECT_GE(workerIndices[i], 0);
+          EXPECT_LE(workerIndices[i], static_cast<int>(nThreads));
+        }
+      }
+    }
+  }
+}
+
+TEST(testThreadPool, testParallelForStealsWork) {
+  // Worker 0 is blocked by a long task, such that its block of the range has to be processed by the others.
+  ThreadPool pool(2);
+  std::promise<void> barrierPromise;
+  std::shared_future<void> barrier = barrierPromise.get_future();
+  auto blocking = pool.run([barrier](int) { barrier.wait(); });
+
+  std::atomic_int counter{0};
+  pool.parallelFor(0, 300, 1, [&](int, int) { counter++; });
+  EXPECT_EQ(counter, 300);
+
+  barrierPromise.set_value();
+  blocking.get();
+}
+
+TEST(testThreadPool, testParallelForRethrows) {
+  ThreadPool pool(2);
+  auto task = [](int, int i) {
+    if (i == 42) {
+      throw std::runtime_error("index exception");
+    }
+  };
+  EXPECT_THROW(pool.parallelFor(0, 100, 1, task), std::runtime_error);
+}
+
+TEST(testThreadPool, testConcurrentParallelCalls) {
+  ThreadPool pool(3);
+  std::atomic_int counter{0};
+
+  auto caller = [&]() {
+    for (int k = 0; k < 100; ++k) {
+      pool.parallelFor(0, 50, 2, [&](int, int) { counter++; });
+    }
+  };
+  std::thread otherCaller(caller);
+  caller();
+  otherCaller.join();
+
+  EXPECT_EQ(counter, 2 * 100 * 50);
+}
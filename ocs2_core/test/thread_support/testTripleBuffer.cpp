@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+TEST(testTripleBuffer, basicPublishUpdate) {
+  ocs2::TripleBuffer<std::string> tripleBuffer;
+  ASSERT_EQ(tripleBuffer.get(), "");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+
+  // publish
+  tripleBuffer.getWriteBuffer() = "update";
+  tripleBuffer.publish();
+  ASSERT_TRUE(tripleBuffer.hasNewValue());
+  ASSERT_EQ(tripleBuffer.get(), "");
+
+  // update
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+
+  // update twice is false
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+
+  // only the latest published value is received
+  tripleBuffer.getWriteBuffer() = "first";
+  tripleBuffer.publish();
+  tripleBuffer.getWriteBuffer() = "second";
+  tripleBuffer.publish();
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "second");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+
+  // reset
+  tripleBuffer.reset();
+  ASSERT_EQ(tripleBuffer.get(), "");
+  ASSERT_FALSE(tripleBuffer.hasNewValue());
+}
+
+TEST(testTripleBuffer, concurrentPublishUpdate) {
+  struct Data {
+    int first = 0;
+    int second = 0;
+  };
+  ocs2::TripleBuffer<Data> tripleBuffer;
+
+  constexpr int numValues = 100000;
+  std::thread producer([&]() {
+    for (int i = 1; i <= numValues; ++i) {
+      auto& data = tripleBuffer.getWriteBuffer();
+      data.first = i;
+      data.second = -i;
+      tripleBuffer.publish();
+    }
+  });
+
+  // The consumer sees consistent values that never go back in time
+  int lastValue = 0;
+  while (lastValue < numValues) {
+    if (tripleBuffer.updateFromBuffer()) {
+      const auto& data = tripleBuffer.get();
+      ASSERT_EQ(data.first, -data.second);
+      ASSERT_GT(data.first, lastValue);
+      lastValue = data.first;
+    }
+  }
+  producer.join();
+}
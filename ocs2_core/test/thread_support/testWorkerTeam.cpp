@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <numeric>
+
+#include <ocs2_core/thread_support/WorkerTeam.h>
+
+using namespace ocs2;
+
+TEST(testWorkerTeam, testRunOnAllMembers) {
+  for (size_t teamSize : {1, 2, 4}) {
+    WorkerTeam team(teamSize);
+    std::vector<int> counter(teamSize, 0);
+
+    for (int k = 0; k < 100; ++k) {
+      team.run([&](int workerIndex) { counter[workerIndex]++; });
+    }
+
+    for (const auto c : counter) {
+      EXPECT_EQ(c, 100);
+    }
+  }
+}
+
+TEST(testWorkerTeam, testBarrierCompletion) {
+  constexpr size_t teamSize = 3;
+  constexpr int numIterations = 200;
+  WorkerTeam team(teamSize, 0, {}, 100);
+
+  int iteration = 0;
+  std::vector<int> data(teamSize, 0);
+  std::atomic_int numMismatches{0};
+  team.run([&](int workerIndex) {
+    while (iteration < numIterations) {
+      data[workerIndex] = iteration;
+      team.barrier([&] {
+        // serial section: all members have written the current iteration
+        for (const auto d : data) {
+          numMismatches += (d != iteration) ? 1 : 0;
+        }
+        ++iteration;
+      });
+    }
+  });
+
+  EXPECT_EQ(iteration, numIterations);
+  EXPECT_EQ(numMismatches, 0);
+}
+
+TEST(testWorkerTeam, testAllReduce) {
+  constexpr size_t teamSize = 4;
+  WorkerTeam team(teamSize);
+
+  std::vector<scalar_t> sums(teamSize), maxima(teamSize);
+  team.run([&](int workerIndex) {
+    for (int k = 0; k < 50; ++k) {
+      sums[workerIndex] = team.allReduce(workerIndex, workerIndex + k, std::plus<scalar_t>());
+      maxima[workerIndex] = team.allReduce(workerIndex, workerIndex * k, [](scalar_t a, scalar_t b) { return std::max(a, b); });
+    }
+  });
+
+  for (size_t i = 0; i < teamSize; ++i) {
+    EXPECT_DOUBLE_EQ(sums[i], 0 + 1 + 2 + 3 + 4 * 49);
+    EXPECT_DOUBLE_EQ(maxima[i], 3 * 49);
+  }
+}
+
+TEST(testWorkerTeam, testRethrows) {
+  WorkerTeam team(3);
+  std::atomic_int counter{0};
+
+  auto task = [&](int workerIndex) {
+    counter++;
+    if (workerIndex == 0) {
+      throw std::runtime_error("worker exception");
+    }
+  };
+  EXPECT_THROW(team.run(task), std::runtime_error);
+  EXPECT_EQ(counter, 3);
+
+  // The team is still usable afterwards
+  counter = 0;
+  team.run([&](int) { counter++; });
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testWorkerTeam, testMakeLocalCopies) {
+  constexpr size_t teamSize = 3;
+  constexpr size_t numCopies = 5;
+  WorkerTeam team(teamSize);
+
+  const std::vector<int> original{1, 2, 3};
+  std::vector<std::vector<int>> copies;
+  team.makeLocalCopies(original, copies, numCopies);
+
+  ASSERT_EQ(copies.size(), numCopies);
+  for (const auto& copy : copies) {
+    EXPECT_EQ(copy, original);
+  }
+}
+
+TEST(testWorkerTeam, testCpuAffinity) {
+  // Pin to a CPU that this process is allowed to run on, e.g. inside a restricted cpuset
+  cpu_set_t processCpus;
+  CPU_ZERO(&processCpus);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &processCpus), 0);
+  int allowedCpu = 0;
+  while (!CPU_ISSET(allowedCpu, &processCpus)) {
+    ++allowedCpu;
+  }
+
+  constexpr size_t teamSize = 3;
+  const std::vector<int> cpuAffinity{allowedCpu};
+  WorkerTeam team(teamSize, 0, cpuAffinity);
+
+  std::vector<int> numAllowedCpus(teamSize, 0);
+  std::vector<bool> isOnAllowedCpu(teamSize, false);
+  team.run([&](int workerIndex) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus), 0);
+    numAllowedCpus[workerIndex] = CPU_COUNT(&cpus);
+    isOnAllowedCpu[workerIndex] = CPU_ISSET(allowedCpu, &cpus);
+  });
+
+  // The worker threads are pinned, the calling thread is not touched
+  for (size_t i = 0; i < teamSize - 1; ++i) {
+    EXPECT_EQ(numAllowedCpus[i], 1);
+    EXPECT_TRUE(isOnAllowedCpu[i]);
+  }
+}
@@ -68,6 +68,8 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** CPU cores of the worker threads, see ThreadPool. */
+  std::vector<int> threadAffinity_;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
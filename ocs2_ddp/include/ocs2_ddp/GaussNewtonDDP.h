@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/misc/AllocationCounter.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/misc/Numerics.h>
@@ -104,7 +105,9 @@ class GaussNewtonDDP : public SolverBase {
   }
 
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const override {
-    return getIntermediateDualSolutionAtTime(nominalDualData_.dualSolution, time);
+    // thread-local, such that the getter can be called concurrently
+    thread_local LinearInterpolation::TimeSegmentCursor timeSegmentCursor;
+    return getIntermediateDualSolutionAtTime(nominalDualData_.dualSolution, time, timeSegmentCursor);
   }
 
   std::string getBenchmarkingInfo() const override;
@@ -121,7 +124,8 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] taskFunction: task function
    * @param [in] N: number of times to run taskFunction, if N = 1 it is run in the main thread
    */
-  void runParallel(std::function<void(void)> taskFunction, size_t N) {
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction, size_t N) {
     threadPool_.runParallel([&](int) { taskFunction(); }, N);
   }
 
@@ -400,6 +404,14 @@ class GaussNewtonDDP : public SolverBase {
   benchmark::RepeatedTimer computeControllerTimer_;
   benchmark::RepeatedTimer searchStrategyTimer_;
   benchmark::RepeatedTimer totalDualSolutionTimer_;
+
+  // Heap allocations per phase, only counted if ocs2_core_allocation_hooks is linked in
+  benchmark::RepeatedAllocationCounter initializationAllocations_;
+  benchmark::RepeatedAllocationCounter linearQuadraticApproximationAllocations_;
+  benchmark::RepeatedAllocationCounter backwardPassAllocations_;
+  benchmark::RepeatedAllocationCounter computeControllerAllocations_;
+  benchmark::RepeatedAllocationCounter searchStrategyAllocations_;
+  benchmark::RepeatedAllocationCounter totalDualSolutionAllocations_;
 };
 
 }  // namespace ocs2
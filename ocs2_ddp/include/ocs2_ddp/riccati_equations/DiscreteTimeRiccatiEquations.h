@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/model_data/ModelData.h>
 
+#include "ocs2_ddp/riccati_equations/FixedSizeDiscreteTimeRiccatiEquations.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 
 namespace ocs2 {
@@ -108,6 +109,16 @@ class DiscreteTimeRiccatiEquations {
                   scalar_t& s);
 
  private:
+  /**
+   * Computes one step Riccati difference equations for ILQR formulation with the fixed-size kernel that is registered for the dimensions
+   * of the problem, see discrete_time_riccati::registerFixedSizeMapILQR().
+   *
+   * @return false if no kernel is registered for the dimensions, in which case the outputs are not computed.
+   */
+  bool computeFixedSizeMapILQR(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                               const matrix_t& SmNext, const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm,
+                               vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s);
+
   /**
    * Computes one step Riccati difference equations for ILQR formulation.
    *
@@ -152,6 +163,11 @@ class DiscreteTimeRiccatiEquations {
   scalar_t riskSensitiveCoeff_ = 0.0;
 
   DiscreteTimeRiccatiData discreteTimeRiccatiData_;
+
+  // the registered fixed-size kernel of the last seen dimensions
+  int fixedSizeMapStateDim_ = -1;
+  int fixedSizeMapInputDim_ = -1;
+  discrete_time_riccati::fixed_size_map_ilqr_t fixedSizeMapILQR_ = nullptr;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,194 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/FixedSizeOcp.h>
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+#include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+
+namespace ocs2 {
+namespace discrete_time_riccati {
+
+/**
+ * Computes one step of the Riccati difference equations for the ILQR formulation with fixed-size types. This is the fixed-size
+ * counterpart of DiscreteTimeRiccatiEquations::computeMap for the risk-neutral case. The sizes of the inputs must match NX and NU, see
+ * hasFixedSizes().
+ *
+ * Only the discrete-time Riccati map of the ILQR variant of the DDP solvers is covered. The continuous-time Riccati equations of SLQ
+ * and the QP solvers of the multiple-shooting solvers (SQP, SLP, IPM) do not use these kernels.
+ *
+ * @tparam NX: The state dimension.
+ * @tparam NU: The projected input dimension.
+ * @param [in] reducedFormRiccati: Whether the reduced form of the Riccati equation is used.
+ * @param [in] projectedModelData: The projected model data.
+ * @param [in] riccatiModification: The RiccatiModification.
+ * @param [in] SmNext: The Riccati matrix of the next time step.
+ * @param [in] SvNext: The Riccati vector of the next time step.
+ * @param [in] sNext: The Riccati scalar of the next time step.
+ * @param [out] projectedKm: The projected feedback controller.
+ * @param [out] projectedLv: The projected feedforward controller.
+ * @param [out] Sm: The current Riccati matrix.
+ * @param [out] Sv: The current Riccati vector.
+ * @param [out] s: The current Riccati scalar.
+ */
+template <int NX, int NU>
+void computeFixedSizeMapILQR(bool reducedFormRiccati, const ModelData& projectedModelData,
+                             const riccati_modification::Data& riccatiModification, const matrix_t& SmNext, const vector_t& SvNext,
+                             const scalar_t& sNext, matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) {
+  using ocp_t = FixedSizeOcp<NX, NU>;
+  using state_vector_t = typename ocp_t::state_vector_t;
+  using input_vector_t = typename ocp_t::input_vector_t;
+  using state_matrix_t = typename ocp_t::state_matrix_t;
+  using input_matrix_t = typename ocp_t::input_matrix_t;
+  using input_state_matrix_t = typename ocp_t::input_state_matrix_t;
+  using state_input_matrix_t = typename ocp_t::state_input_matrix_t;
+
+  const typename ocp_t::ScalarFunctionQuadraticApproximation cost(projectedModelData.cost);
+  const state_matrix_t Am = projectedModelData.dynamics.dfdx;
+  const state_input_matrix_t Bm = projectedModelData.dynamics.dfdu;
+  const state_vector_t Hv = projectedModelData.dynamicsBias;
+  const state_matrix_t SmNextFixed = SmNext;
+
+  // precomputation (1)
+  const state_vector_t Sm_Hv = SmNextFixed * Hv;
+  const state_matrix_t Sm_Am = SmNextFixed * Am;
+  const state_input_matrix_t Sm_Bm = SmNextFixed * Bm;
+  const state_vector_t Sv_plus_Sm_Hv = SvNext + Sm_Hv;
+
+  // Gm = Pm + Bm^T * Sm * Am
+  input_state_matrix_t Gm = cost.dfdux;
+  Gm.noalias() += Bm.transpose() * Sm_Am;
+
+  // Gv = Rv + Bm^T * (Sv + Sm * Hv)
+  input_vector_t Gv = cost.dfdu;
+  Gv.noalias() += Bm.transpose() * Sv_plus_Sm_Hv;
+
+  // projected feedback and feedforward
+  const input_state_matrix_t Km = -Gm - riccatiModification.deltaGm_;
+  const input_vector_t Lv = -Gv - riccatiModification.deltaGv_;
+
+  // precomputation (2)
+  const state_matrix_t Km_T_Gm = Km.transpose() * Gm;
+
+  // Sm = Qm + deltaQm + Am^T * Sm * Am + ...
+  state_matrix_t SmFixed = cost.dfdxx + riccatiModification.deltaQm_;
+  SmFixed.noalias() += Sm_Am.transpose() * Am;
+
+  // Sv = Qv + Am^T * (Sv + Sm * Hv) + Gm^T * Lv + ...
+  state_vector_t SvFixed = cost.dfdx;
+  SvFixed.noalias() += Am.transpose() * Sv_plus_Sm_Hv;
+  SvFixed.noalias() += Gm.transpose() * Lv;
+
+  // s = s + q + Hv^T * (Sv + Sm * Hv) - 0.5 Hv^T * Sm * Hv + ...
+  s = sNext + cost.f + Hv.dot(Sv_plus_Sm_Hv) - 0.5 * Hv.dot(Sm_Hv);
+
+  if (reducedFormRiccati) {
+    SmFixed += Km_T_Gm;
+    s += 0.5 * Lv.dot(Gv);
+  } else {
+    input_matrix_t Hm = cost.dfduu;
+    Hm.noalias() += Sm_Bm.transpose() * Bm;
+    const input_state_matrix_t Hm_Km = Hm * Km;
+
+    SmFixed += Km_T_Gm + Km_T_Gm.transpose();
+    SmFixed.noalias() += Km.transpose() * Hm_Km;
+    SvFixed.noalias() += Km.transpose() * Gv;
+    SvFixed.noalias() += Hm_Km.transpose() * Lv;
+    s += Lv.dot(Gv) + 0.5 * Lv.dot(Hm * Lv);
+  }
+
+  projectedKm = Km;
+  projectedLv = Lv;
+  Sm = SmFixed;
+  Sv = SvFixed;
+}
+
+/**
+ * Whether the inputs of computeFixedSizeMapILQR<NX, NU> have the fixed sizes.
+ */
+template <int NX, int NU>
+bool hasFixedSizes(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
+                   const vector_t& SvNext) {
+  const auto& dynamics = projectedModelData.dynamics;
+  return FixedSizeOcp<NX, NU>::hasDimensions(projectedModelData.cost) && dynamics.dfdx.rows() == NX && dynamics.dfdx.cols() == NX &&
+         dynamics.dfdu.rows() == NX && dynamics.dfdu.cols() == NU && projectedModelData.dynamicsBias.size() == NX &&
+         riccatiModification.deltaQm_.rows() == NX && riccatiModification.deltaQm_.cols() == NX &&
+         riccatiModification.deltaGm_.rows() == NU && riccatiModification.deltaGm_.cols() == NX &&
+         riccatiModification.deltaGv_.size() == NU && SmNext.rows() == NX && SmNext.cols() == NX && SvNext.size() == NX;
+}
+
+/**
+ * Runs computeFixedSizeMapILQR<NX, NU> if the inputs have the fixed sizes.
+ *
+ * @return false if the sizes do not match and the outputs are not computed.
+ */
+template <int NX, int NU>
+bool tryFixedSizeMapILQR(bool reducedFormRiccati, const ModelData& projectedModelData,
+                         const riccati_modification::Data& riccatiModification, const matrix_t& SmNext, const vector_t& SvNext,
+                         const scalar_t& sNext, matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) {
+  if (!hasFixedSizes<NX, NU>(projectedModelData, riccatiModification, SmNext, SvNext)) {
+    return false;
+  }
+  computeFixedSizeMapILQR<NX, NU>(reducedFormRiccati, projectedModelData, riccatiModification, SmNext, SvNext, sNext, projectedKm,
+                                  projectedLv, Sm, Sv, s);
+  return true;
+}
+
+/** The type of a registered fixed-size ILQR kernel, see tryFixedSizeMapILQR(). */
+using fixed_size_map_ilqr_t = bool (*)(bool, const ModelData&, const riccati_modification::Data&, const matrix_t&, const vector_t&,
+                                       const scalar_t&, matrix_t&, vector_t&, matrix_t&, vector_t&, scalar_t&);
+
+/**
+ * Registers a fixed-size ILQR kernel for the given state and projected input dimensions. DiscreteTimeRiccatiEquations uses the registered
+ * kernel for problems of these dimensions instead of the dynamic-size implementation. ocs2_ddp does not register any kernel itself,
+ * applications opt in through registerFixedSizeMapILQR<NX, NU>() before the solver is constructed. This pays off for very small systems
+ * (e.g., the cartpole and the double integrator) only. This function is thread safe.
+ *
+ * @param [in] stateDim: The state dimension.
+ * @param [in] inputDim: The projected input dimension.
+ * @param [in] fixedSizeMap: The kernel. A later registration for the same dimensions replaces the earlier one.
+ */
+void registerFixedSizeMapILQR(int stateDim, int inputDim, fixed_size_map_ilqr_t fixedSizeMap);
+
+/** Registers tryFixedSizeMapILQR<NX, NU> for the dimensions (NX, NU). */
+template <int NX, int NU>
+void registerFixedSizeMapILQR() {
+  registerFixedSizeMapILQR(NX, NU, &tryFixedSizeMapILQR<NX, NU>);
+}
+
+/**
+ * Returns the registered fixed-size ILQR kernel for the given dimensions, or nullptr if there is none. This function is thread safe.
+ */
+fixed_size_map_ilqr_t getFixedSizeMapILQR(int stateDim, int inputDim);
+
+}  // namespace discrete_time_riccati
+}  // namespace ocs2
@@ -53,7 +53,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_, ddpSettings_.threadAffinity_) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -162,6 +163,15 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
                << searchStrategyTotal / benchmarkTotal * 100 << "%)\n";
     infoStream << "\tDual Solution      :\t" << totalDualSolutionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << dualSolutionTotal / benchmarkTotal * 100 << "%)\n\n";
+    if (benchmark::isAllocationCounterInstalled()) {
+      infoStream << "DDP Allocations\t   :\tAverage heap allocations per call (average memory)\n";
+      infoStream << "\tInitialization     :\t" << benchmark::toString(initializationAllocations_) << "\n";
+      infoStream << "\tLQ Approximation   :\t" << benchmark::toString(linearQuadraticApproximationAllocations_) << "\n";
+      infoStream << "\tBackward Pass      :\t" << benchmark::toString(backwardPassAllocations_) << "\n";
+      infoStream << "\tCompute Controller :\t" << benchmark::toString(computeControllerAllocations_) << "\n";
+      infoStream << "\tSearch Strategy    :\t" << benchmark::toString(searchStrategyAllocations_) << "\n";
+      infoStream << "\tDual Solution      :\t" << benchmark::toString(totalDualSolutionAllocations_) << "\n\n";
+    }
   }
   return infoStream.str();
 }
@@ -197,6 +207,12 @@ void GaussNewtonDDP::reset() {
   computeControllerTimer_.reset();
   searchStrategyTimer_.reset();
   totalDualSolutionTimer_.reset();
+  initializationAllocations_.reset();
+  linearQuadraticApproximationAllocations_.reset();
+  backwardPassAllocations_.reset();
+  computeControllerAllocations_.reset();
+  searchStrategyAllocations_.reset();
+  totalDualSolutionAllocations_.reset();
 }
 
 /******************************************************************************************************/
@@ -656,8 +672,7 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
    * also call shiftHessian on the event time's cost 2nd order derivative.
    */
   const size_t NE = nominalPrimalData_.primalSolution.postEventIndices_.size();
-  nominalPrimalData_.modelDataEventTimes.clear();
-  nominalPrimalData_.modelDataEventTimes.resize(NE);
+  nominalPrimalData_.modelDataEventTimes.resize(NE);  // keep the existing elements such that their memory is reused
   if (NE > 0) {
     nextTimeIndex_ = 0;
     nextTaskId_ = 0;
@@ -873,6 +888,7 @@ bool GaussNewtonDDP::initializePrimalSolution() {
 void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
   // adjust dual solution
   totalDualSolutionTimer_.startTimer();
+  totalDualSolutionAllocations_.startCounter();
   if (!optimizedDualSolution_.timeTrajectory.empty()) {
     const auto status =
         trajectorySpread(optimizedPrimalSolution_.modeSchedule_, nominalPrimalData_.primalSolution.modeSchedule_, optimizedDualSolution_);
@@ -881,6 +897,7 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
   // initialize dual solution
   ocs2::initializeDualSolution(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, optimizedDualSolution_,
                                nominalDualData_.dualSolution);
+  totalDualSolutionAllocations_.endCounter();
   totalDualSolutionTimer_.endTimer();
 
   computeRolloutMetrics(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, nominalDualData_.dualSolution,
@@ -903,6 +920,7 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
+  searchStrategyAllocations_.startCounter();
   scalar_t avgTimeStep;
   const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
   search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, optimizedProblemMetrics_,
@@ -913,15 +931,18 @@ void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   if (success) {
     avgTimeStepFP_ = 0.9 * avgTimeStepFP_ + 0.1 * avgTimeStep;
   }
+  searchStrategyAllocations_.endCounter();
   searchStrategyTimer_.endTimer();
 
   // update dual
   totalDualSolutionTimer_.startTimer();
+  totalDualSolutionAllocations_.startCounter();
   if (success) {
     ocs2::updateDualSolution(optimalControlProblemStock_[0], optimizedPrimalSolution_, optimizedProblemMetrics_, optimizedDualSolution_);
     performanceIndex_ = computeRolloutPerformanceIndex(optimizedPrimalSolution_.timeTrajectory_, optimizedProblemMetrics_);
     performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
   }
+  totalDualSolutionAllocations_.endCounter();
   totalDualSolutionTimer_.endTimer();
 
   // if failed, use nominal and to keep the consistency of cached data, all cache should be left untouched
@@ -1012,9 +1033,11 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // optimized --> nominal: initializes the nominal primal and dual solutions based on the optimized ones
   initializationTimer_.startTimer();
+  initializationAllocations_.startCounter();
   bool initialSolutionExists = initializePrimalSolution();  // true if the rollout is not purely from the Initializer
   initializeDualSolutionAndMetrics();
   performanceIndexHistory_.push_back(performanceIndex_);
+  initializationAllocations_.endCounter();
   initializationTimer_.endTimer();
 
   // display
@@ -1036,17 +1059,23 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     // nominal --> nominal: constructs the LQ problem around the nominal trajectories
     linearQuadraticApproximationTimer_.startTimer();
+    linearQuadraticApproximationAllocations_.startCounter();
     approximateOptimalControlProblem();
+    linearQuadraticApproximationAllocations_.endCounter();
     linearQuadraticApproximationTimer_.endTimer();
 
     // nominal --> nominal: solves the LQ problem
     backwardPassTimer_.startTimer();
+    backwardPassAllocations_.startCounter();
     avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+    backwardPassAllocations_.endCounter();
     backwardPassTimer_.endTimer();
 
     // calculate controller and store the result in unoptimizedController_
     computeControllerTimer_.startTimer();
+    computeControllerAllocations_.startCounter();
     calculateController();
+    computeControllerAllocations_.endCounter();
     computeControllerTimer_.endTimer();
 
     // the expected cost/merit calculated by the Riccati solution is not reliable
@@ -84,7 +84,7 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
   const auto& multiplierTrajectory = dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
-  modelDataTrajectory.clear();
+  // keep the existing elements such that their memory is reused
   modelDataTrajectory.resize(timeTrajectory.size());
 
   nextTimeIndex_ = 0;
@@ -53,12 +53,33 @@ void DiscreteTimeRiccatiEquations::computeMap(const ModelData& projectedModelDat
   if (isRiskSensitive_) {
     computeMapILEG(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
                    Sv, s);
-  } else {
+  } else if (!computeFixedSizeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, projectedKm, projectedLv, Sm, Sv,
+                                      s)) {
     computeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
                    Sv, s);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool DiscreteTimeRiccatiEquations::computeFixedSizeMapILQR(const ModelData& projectedModelData,
+                                                           const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
+                                                           const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm,
+                                                           vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) {
+  // look up the registered kernel only when the dimensions change
+  const int stateDim = projectedModelData.dynamics.dfdx.rows();
+  const int inputDim = projectedModelData.dynamics.dfdu.cols();
+  if (stateDim != fixedSizeMapStateDim_ || inputDim != fixedSizeMapInputDim_) {
+    fixedSizeMapILQR_ = discrete_time_riccati::getFixedSizeMapILQR(stateDim, inputDim);
+    fixedSizeMapStateDim_ = stateDim;
+    fixedSizeMapInputDim_ = inputDim;
+  }
+
+  return fixedSizeMapILQR_ != nullptr && fixedSizeMapILQR_(reducedFormRiccati_, projectedModelData, riccatiModification, SmNext, SvNext,
+                                                           sNext, projectedKm, projectedLv, Sm, Sv, s);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,71 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/FixedSizeDiscreteTimeRiccatiEquations.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace ocs2 {
+namespace discrete_time_riccati {
+
+namespace {
+struct FixedSizeMapRegistry {
+  std::mutex mutex;
+  std::map<std::pair<int, int>, fixed_size_map_ilqr_t> maps;
+};
+
+FixedSizeMapRegistry& getFixedSizeMapRegistry() {
+  static FixedSizeMapRegistry registry;
+  return registry;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void registerFixedSizeMapILQR(int stateDim, int inputDim, fixed_size_map_ilqr_t fixedSizeMap) {
+  auto& registry = getFixedSizeMapRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.maps[{stateDim, inputDim}] = fixedSizeMap;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+fixed_size_map_ilqr_t getFixedSizeMapILQR(int stateDim, int inputDim) {
+  auto& registry = getFixedSizeMapRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto it = registry.maps.find({stateDim, inputDim});
+  return (it != registry.maps.end()) ? it->second : nullptr;
+}
+
+}  // namespace discrete_time_riccati
+}  // namespace ocs2
@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/FixedSizeDiscreteTimeRiccatiEquations.h>
 
 class RiccatiInitializer {
  public:
@@ -104,6 +106,59 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+namespace {
+size_t numFixedSizeMapCalls = 0;
+
+template <int NX, int NU>
+bool countingFixedSizeMapILQR(bool reducedFormRiccati, const ocs2::ModelData& projectedModelData,
+                              const ocs2::riccati_modification::Data& riccatiModification, const ocs2::matrix_t& SmNext,
+                              const ocs2::vector_t& SvNext, const ocs2::scalar_t& sNext, ocs2::matrix_t& projectedKm,
+                              ocs2::vector_t& projectedLv, ocs2::matrix_t& Sm, ocs2::vector_t& Sv, ocs2::scalar_t& s) {
+  ++numFixedSizeMapCalls;
+  return ocs2::discrete_time_riccati::tryFixedSizeMapILQR<NX, NU>(reducedFormRiccati, projectedModelData, riccatiModification, SmNext,
+                                                                   SvNext, sNext, projectedKm, projectedLv, Sm, Sv, s);
+}
+}  // unnamed namespace
+
+TEST(RiccatiTest, compareFixedSizeDiscreteImplementation) {
+  // dimensions without a registered fixed-size kernel, such that DiscreteTimeRiccatiEquations first uses the dynamic-size implementation
+  constexpr int STATE_DIM = 5;
+  constexpr int INPUT_DIM = 2;
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  const auto& projectedModelData = ri.projectedModelDataTrajectory.front();
+  const auto& riccatiModification = ri.riccatiModificationTrajectory.front();
+  const ocs2::matrix_t SmNext = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  const ocs2::vector_t SvNext = ocs2::vector_t::Random(STATE_DIM);
+  const ocs2::scalar_t sNext = 0.3;
+
+  ASSERT_TRUE((ocs2::discrete_time_riccati::hasFixedSizes<STATE_DIM, INPUT_DIM>(projectedModelData, riccatiModification, SmNext, SvNext)));
+  ASSERT_FALSE((ocs2::discrete_time_riccati::hasFixedSizes<STATE_DIM, 1>(projectedModelData, riccatiModification, SmNext, SvNext)));
+  ASSERT_EQ(ocs2::discrete_time_riccati::getFixedSizeMapILQR(STATE_DIM, INPUT_DIM), nullptr);
+
+  for (const bool reducedFormRiccati : {true, false}) {
+    ocs2::matrix_t Km, KmFixed, Sm, SmFixed;
+    ocs2::vector_t Lv, LvFixed, Sv, SvFixed;
+    ocs2::scalar_t s, sFixed;
+    ocs2::DiscreteTimeRiccatiEquations(reducedFormRiccati)
+        .computeMap(projectedModelData, riccatiModification, SmNext, SvNext, sNext, Km, Lv, Sm, Sv, s);
+
+    // opt in for the fixed-size kernel, counting its calls
+    ocs2::discrete_time_riccati::registerFixedSizeMapILQR(STATE_DIM, INPUT_DIM, &countingFixedSizeMapILQR<STATE_DIM, INPUT_DIM>);
+    numFixedSizeMapCalls = 0;
+    ocs2::DiscreteTimeRiccatiEquations(reducedFormRiccati)
+        .computeMap(projectedModelData, riccatiModification, SmNext, SvNext, sNext, KmFixed, LvFixed, SmFixed, SvFixed, sFixed);
+    ocs2::discrete_time_riccati::registerFixedSizeMapILQR(STATE_DIM, INPUT_DIM, nullptr);
+    EXPECT_EQ(numFixedSizeMapCalls, 1);
+
+    EXPECT_TRUE(KmFixed.isApprox(Km));
+    EXPECT_TRUE(LvFixed.isApprox(Lv));
+    EXPECT_TRUE(SmFixed.isApprox(Sm));
+    EXPECT_TRUE(SvFixed.isApprox(Sv));
+    EXPECT_NEAR(sFixed, s, 1e-9);
+  }
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
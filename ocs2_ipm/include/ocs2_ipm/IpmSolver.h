@@ -32,9 +32,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 
+#include <ocs2_oc/multiple_shooting/NodeScheduler.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/SpeculativeLinesearch.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -111,7 +113,10 @@ class IpmSolver : public SolverBase {
   }
 
   /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction) {
+    workerTeam_.run(std::forward<Functor>(taskFunction));
+  }
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -141,6 +146,12 @@ class IpmSolver : public SolverBase {
                                       const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                       const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
 
+  /** Computes the performance metrics of node i, without the initial state constraint */
+  PerformanceIndex computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, int i,
+                                          const vector_array_t& x, const vector_array_t& u, scalar_t barrierParam,
+                                          const vector_array_t& slackStateIneq, const vector_array_t& slackStateInputIneq,
+                                          Metrics& metrics);
+
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;    // delta_x(t)
@@ -173,6 +184,12 @@ class IpmSolver : public SolverBase {
                                vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
 
+  /** Same as takePrimalStep, but evaluates settings.linesearchBatchSize step sizes concurrently */
+  ipm::StepInfo takeSpeculativePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                          const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                          vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
+                                          vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+
   /** Updates the Lagrange multipliers */
   void takeDualStep(const OcpSubproblemSolution& subproblemSolution, const ipm::StepInfo& stepInfo, vector_array_t& lmd, vector_array_t& nu,
                     vector_array_t& dualStateIneq, vector_array_t& dualStateInputIneq) const;
@@ -196,7 +213,16 @@ class IpmSolver : public SolverBase {
   HpipmInterface hpipmInterface_;
 
   // Threading
-  ThreadPool threadPool_;
+  WorkerTeam workerTeam_;
+  multiple_shooting::NodeScheduler linearizationScheduler_;
+  multiple_shooting::NodeScheduler performanceScheduler_;
+  multiple_shooting::NodeScheduler solutionScheduler_;
+  multiple_shooting::SpeculativeLinesearch speculativeLinesearch_;
+  std::vector<vector_array_t> candidateStates_;  // state trajectories of the speculative linesearch candidates
+  std::vector<vector_array_t> candidateInputs_;  // input trajectories of the speculative linesearch candidates
+  std::vector<vector_array_t> candidateSlackStateIneq_;       // state-only slacks of the speculative linesearch candidates
+  std::vector<vector_array_t> candidateSlackStateInputIneq_;  // state-input slacks of the speculative linesearch candidates
+  std::vector<std::vector<Metrics>> candidateMetrics_;  // metrics of the speculative linesearch candidates
 
   // Solution
   PrimalSolution primalSolution_;
@@ -219,6 +245,9 @@ class IpmSolver : public SolverBase {
   // Constraint terms size
   std::vector<multiple_shooting::ConstraintsSize> constraintsSize_;
 
+  // Transcription of the intermediate nodes. It is kept across iterations and MPC calls, such that the memory of a node is reused.
+  std::vector<multiple_shooting::Transcription> transcriptions_;
+
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
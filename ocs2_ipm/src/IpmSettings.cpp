@@ -54,6 +54,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.linesearchBatchSize, fieldName + ".linesearchBatchSize", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
@@ -83,6 +84,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadStdVector(filename, fieldName + ".threadAffinity", settings.threadAffinity, verbose);
+  auto nodeSchedulingName = multiple_shooting::node_scheduling::toString(settings.nodeScheduling);
+  loadData::loadPtreeValue(pt, nodeSchedulingName, fieldName + ".nodeScheduling", verbose);
+  settings.nodeScheduling = multiple_shooting::node_scheduling::fromString(nodeSchedulingName);
+  loadData::loadPtreeValue(pt, settings.nodeSchedulingGrainSize, fieldName + ".nodeSchedulingGrainSize", verbose);
 
   if (settings.initialSlackLowerBound <= 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialSlackLowerBound must be positive!");
@@ -66,7 +66,16 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
 IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      workerTeam_(std::max(settings_.nThreads, size_t(1)), settings_.threadPriority, settings_.threadAffinity),
+      linearizationScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      performanceScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      solutionScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      speculativeLinesearch_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      candidateStates_(settings_.linesearchBatchSize),
+      candidateInputs_(settings_.linesearchBatchSize),
+      candidateSlackStateIneq_(settings_.linesearchBatchSize),
+      candidateSlackStateInputIneq_(settings_.linesearchBatchSize),
+      candidateMetrics_(settings_.linesearchBatchSize) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -75,9 +84,7 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
   // Clone objects to have one for each worker
-  for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
-  }
+  workerTeam_.makeLocalCopies(optimalControlProblem, ocpDefinitions_, settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -194,7 +201,9 @@ vector_t IpmSolver::getStateInputEqualityConstraintLagrangian(scalar_t time, con
 
 MultiplierCollection IpmSolver::getIntermediateDualSolution(scalar_t time) const {
   if (!dualIneqTrajectory_.timeTrajectory.empty()) {
-    return getIntermediateDualSolutionAtTime(dualIneqTrajectory_, time);
+    // thread-local, such that the getter can be called concurrently
+    thread_local LinearInterpolation::TimeSegmentCursor timeSegmentCursor;
+    return getIntermediateDualSolutionAtTime(dualIneqTrajectory_, time, timeSegmentCursor);
   } else {
     throw std::runtime_error("[IpmSolver] getIntermediateDualSolution() not available yet.");
   }
@@ -311,10 +320,6 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void IpmSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
-}
-
 void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& timeDiscretization, const vector_array_t& stateTrajectory,
                                             vector_array_t& costateTrajectory) const {
   costateTrajectory.clear();
@@ -418,6 +423,7 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
   dualStateInputIneq.resize(N);
 
   int eventIdx = 0;
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor;  // the nodes are visited in time order
   for (size_t i = 0; i < N; i++) {
     if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
       const auto cachedEventIndex = cacheEventIndexBias + eventIdx;
@@ -438,9 +444,9 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       if (interpolatableTimePeriod.first <= time && time <= interpolatableTimePeriod.second) {
         std::tie(slackStateIneq[i], slackStateInputIneq[i]) =
-            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time));
+            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time, timeSegmentCursor));
         std::tie(dualStateIneq[i], dualStateInputIneq[i]) =
-            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time));
+            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time, timeSegmentCursor));
       } else {
         std::tie(slackStateIneq[i], slackStateInputIneq[i]) = ipm::initializeIntermediateSlackVariable(
             ocpDefinition, time, x[i], u[i], settings_.initialSlackLowerBound, settings_.initialSlackMarginRate);
@@ -510,13 +516,29 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   scalar_array_t primalStepSizes(settings_.nThreads, 1.0);
   scalar_array_t dualStepSizes(settings_.nThreads, 1.0);
 
-  std::atomic_int timeIndex{0};
+  solutionScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     vector_t tmp;  // 1 temporary for re-use for projection.
 
-    int i = timeIndex++;
-    while (i < N) {
+    solutionScheduler_.forEachNode(workerId, [&](int i) {
+      if (i == N) {
+        deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
+        deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+        primalStepSizes[workerId] =
+            std::min(primalStepSizes[workerId],
+                     ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
+        dualStepSizes[workerId] =
+            std::min(dualStepSizes[workerId],
+                     ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i], settings_.fractionToBoundaryMargin));
+        // Extract Newton directions of the costate
+        if (settings_.computeLagrangeMultipliers) {
+          deltaLmdSol[0] = valueFunction_[0].dfdx;
+          deltaLmdSol[0].noalias() += valueFunction_[i].dfdxx * deltaXSol[0];
+        }
+        return;
+      }
+
       deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
       deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
       deltaSlackStateInputIneq[i] =
@@ -550,24 +572,7 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
         deltaUSol[i] = tmp + constraintsProjection_[i].f;
         deltaUSol[i].noalias() += constraintsProjection_[i].dfdx * deltaXSol[i];
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
-      primalStepSizes[workerId] =
-          std::min(primalStepSizes[workerId],
-                   ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
-      dualStepSizes[workerId] = std::min(dualStepSizes[workerId], ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i],
-                                                                                                  settings_.fractionToBoundaryMargin));
-      // Extract Newton directions of the costate
-      if (settings_.computeLagrangeMultipliers) {
-        deltaLmdSol[0] = valueFunction_[0].dfdx;
-        deltaLmdSol[0].noalias() += valueFunction_[i].dfdxx * deltaXSol[0];
-      }
-    }
+    });
   };
   runParallel(std::move(parallelTask));
 
@@ -620,16 +625,34 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
   constraintsSize_.resize(N + 1);
+  transcriptions_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
+  linearizationScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    linearizationScheduler_.forEachNode(workerId, [&](int i) {
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+        metrics[i] = multiple_shooting::computeMetrics(result);
+        performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[N]);
+        stateInputEqConstraints_[i].resize(0, x[i].size());
+        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+        constraintsSize_[i] = std::move(result.constraintsSize);
+        if (settings_.computeLagrangeMultipliers) {
+          lagrangian_[i] = multiple_shooting::evaluateLagrangianTerminalNode(lmd[i], std::move(result.cost));
+        } else {
+          lagrangian_[i] = std::move(result.cost);
+        }
+        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N]);
+        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
+        performance[workerId].dualFeasibilitiesSSE +=
+            ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
         metrics[i] = multiple_shooting::computeMetrics(result);
@@ -655,7 +678,8 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        auto& result = transcriptions_[i];
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
           result.stateIneqConstraints.setZero(0, x[i].size());
@@ -664,18 +688,18 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
         metrics[i] = multiple_shooting::computeMetrics(result);
         performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
         multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-        constraintsSize_[i] = std::move(result.constraintsSize);
+        // Swap instead of move, such that the transcription keeps the memory of the previous iteration
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+        std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
+        std::swap(constraintsSize_[i], result.constraintsSize);
+        std::swap(lagrangian_[i], result.cost);
         if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
+          lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(lagrangian_[i]),
                                                                                  dynamics_[i], stateInputEqConstraints_[i]);
-        } else {
-          lagrangian_[i] = std::move(result.cost);
         }
 
         ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
@@ -687,27 +711,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
         performance[workerId].dualFeasibilitiesSSE +=
             ipm::evaluateComplementarySlackness(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i]);
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[N]);
-      stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-      constraintsSize_[i] = std::move(result.constraintsSize);
-      if (settings_.computeLagrangeMultipliers) {
-        lagrangian_[i] = multiple_shooting::evaluateLagrangianTerminalNode(lmd[i], std::move(result.cost));
-      } else {
-        lagrangian_[i] = std::move(result.cost);
-      }
-      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N]);
-      performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
-      performance[workerId].dualFeasibilitiesSSE += ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
-    }
+    });
   };
   runParallel(std::move(parallelTask));
 
@@ -731,38 +735,15 @@ PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>&
   metrics.resize(N + 1);
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  performanceScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        // Disable the state-only inequality constraints at the initial node
-        if (i == 0) {
-          metrics[i].stateIneqConstraint.clear();
-        }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
-    }
+    performanceScheduler_.forEachNode(workerId, [&](int i) {
+      performance[workerId] +=
+          computeNodePerformance(ocpDefinition, time, i, x, u, barrierParam, slackStateIneq, slackStateInputIneq, metrics[i]);
+    });
   };
   runParallel(std::move(parallelTask));
 
@@ -777,12 +758,44 @@ PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>&
   return totalPerformance;
 }
 
+PerformanceIndex IpmSolver::computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, int i,
+                                                   const vector_array_t& x, const vector_array_t& u, scalar_t barrierParam,
+                                                   const vector_array_t& slackStateIneq, const vector_array_t& slackStateInputIneq,
+                                                   Metrics& metrics) {
+  const int N = static_cast<int>(time.size()) - 1;
+  if (i == N) {
+    // Terminal node
+    const scalar_t tN = getIntervalStart(time[N]);
+    metrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+    return ipm::toPerformanceIndex(metrics, barrierParam, slackStateIneq[N]);
+  } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    metrics = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+    return ipm::toPerformanceIndex(metrics, barrierParam, slackStateIneq[i]);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    metrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+    // Disable the state-only inequality constraints at the initial node
+    if (i == 0) {
+      metrics.stateIneqConstraint.clear();
+    }
+    return ipm::toPerformanceIndex(metrics, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+  }
+}
+
 ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                         const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                         vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                         vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.linesearchBatchSize > 1) {
+    return takeSpeculativePrimalStep(baseline, timeDiscretization, initState, subproblemSolution, x, u, barrierParam, slackStateIneq,
+                                     slackStateInputIneq, metrics);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -883,6 +896,96 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   return stepInfo;
 }
 
+ipm::StepInfo IpmSolver::takeSpeculativePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
+                                                   vector_array_t& x, vector_array_t& u, scalar_t barrierParam,
+                                                   vector_array_t& slackStateIneq, vector_array_t& slackStateInputIneq,
+                                                   std::vector<Metrics>& metrics) {
+  using StepType = FilterLinesearch::StepType;
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto& deltaSlackStateIneq = subproblemSolution.deltaSlackStateIneq;
+  const auto& deltaSlackStateInputIneq = subproblemSolution.deltaSlackStateInputIneq;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  const auto stepSizes = multiple_shooting::SpeculativeLinesearch::getStepSizes(
+      subproblemSolution.maxPrimalStepSize, settings_.alpha_decay, settings_.alpha_min, settings_.deltaTol, deltaXnorm, deltaUnorm);
+  const int numNodes = static_cast<int>(timeDiscretization.size());
+  const size_t batchSize = std::min(settings_.linesearchBatchSize, stepSizes.size());
+  // The candidate buffers keep their memory across iterations, resizing is a no-op once the horizon is stable
+  auto& xNew = candidateStates_;
+  auto& uNew = candidateInputs_;
+  auto& slackStateIneqNew = candidateSlackStateIneq_;
+  auto& slackStateInputIneqNew = candidateSlackStateInputIneq_;
+  auto& metricsNew = candidateMetrics_;
+  for (size_t c = 0; c < batchSize; c++) {
+    xNew[c].resize(x.size());
+    uNew[c].resize(u.size());
+    slackStateIneqNew[c].resize(slackStateIneq.size());
+    slackStateInputIneqNew[c].resize(slackStateInputIneq.size());
+    metricsNew[c].resize(numNodes);
+  }
+
+  const int accepted = speculativeLinesearch_.backtrack(
+      workerTeam_, filterLinesearch_, baseline, subproblemSolution.armijoDescentMetric, stepSizes, batchSize, numNodes,
+      [&](int c, scalar_t alpha) {
+        multiple_shooting::incrementTrajectory(u, du, alpha, uNew[c]);
+        multiple_shooting::incrementTrajectory(x, dx, alpha, xNew[c]);
+        multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, slackStateIneqNew[c]);
+        multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, slackStateInputIneqNew[c]);
+      },
+      [&](int workerId, int c, int i) {
+        auto performance = computeNodePerformance(ocpDefinitions_[workerId], timeDiscretization, i, xNew[c], uNew[c], barrierParam,
+                                                  slackStateIneqNew[c], slackStateInputIneqNew[c], metricsNew[c][i]);
+        if (i == 0) {
+          // Account for initial state in performance
+          const vector_t initDynamicsViolation = initState - xNew[c].front();
+          metricsNew[c].front().dynamicsViolation += initDynamicsViolation;
+          performance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+        }
+        return performance;
+      },
+      settings_.printLinesearch, deltaXnorm, deltaUnorm);
+
+  if (accepted >= 0) {  // Return if step accepted
+    const auto& candidate = speculativeLinesearch_.getCandidates()[accepted];
+    x.swap(xNew[accepted]);
+    u.swap(uNew[accepted]);
+    slackStateIneq.swap(slackStateIneqNew[accepted]);
+    slackStateInputIneq.swap(slackStateInputIneqNew[accepted]);
+    metrics.swap(metricsNew[accepted]);
+
+    // Prepare step info
+    ipm::StepInfo stepInfo;
+    stepInfo.primalStepSize = candidate.stepSize;
+    stepInfo.stepType = candidate.stepType;
+    stepInfo.dx_norm = candidate.stepSize * deltaXnorm;
+    stepInfo.du_norm = candidate.stepSize * deltaUnorm;
+    stepInfo.performanceAfterStep = candidate.performance;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(candidate.performance);
+    return stepInfo;
+  }
+
+  // Alpha_min reached -> Don't take a step
+  ipm::StepInfo stepInfo;
+  stepInfo.primalStepSize = 0.0;
+  stepInfo.stepType = StepType::ZERO;
+  stepInfo.dx_norm = 0.0;
+  stepInfo.du_norm = 0.0;
+  stepInfo.performanceAfterStep = baseline;
+  stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+
+  if (settings_.printLinesearch) {
+    std::cerr << "[Linesearch terminated] Primal Step size: " << stepInfo.primalStepSize << ", Step Type: " << toString(stepInfo.stepType)
+              << "\n";
+  }
+
+  return stepInfo;
+}
+
 void IpmSolver::takeDualStep(const OcpSubproblemSolution& subproblemSolution, const ipm::StepInfo& stepInfo, vector_array_t& lmd,
                              vector_array_t& nu, vector_array_t& dualStateIneq, vector_array_t& dualStateInputIneq) const {
   if (settings_.computeLagrangeMultipliers) {
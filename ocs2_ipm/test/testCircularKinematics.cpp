@@ -343,4 +343,66 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints_MixedIneqConstraint
   for (const auto e : shiftTime) {
     solver.run(startTime + e, initState, finalTime + e);
   }
-}
\ No newline at end of file
+}
+TEST(test_circular_kinematics, solve_speculativeLinesearch) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // inequality constraints
+  const scalar_t xumin = -2.0;
+  const scalar_t xumax = 2.0;
+  problem.inequalityConstraintPtr->add("xubound", std::make_unique<CircleKinematics_MixedStateInputIneqConstraints>(xumin, xumax));
+
+  // Initializer
+  DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto settings = []() {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 20;
+    s.useFeedbackPolicy = true;
+    s.computeLagrangeMultipliers = true;
+    s.printLinesearch = true;
+    s.nThreads = 3;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+    s.barrierLinearDecreaseFactor = 0.2;
+    s.barrierSuperlinearDecreasePower = 1.5;
+    s.fractionToBoundaryMargin = 0.995;
+    return s;
+  }();
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with the serial linesearch
+  IpmSolver serialSolver(settings, problem, zeroInitializer);
+  serialSolver.run(startTime, initState, finalTime);
+
+  // Solve with several step sizes evaluated in parallel
+  settings.linesearchBatchSize = 4;
+  IpmSolver speculativeSolver(settings, problem, zeroInitializer);
+  speculativeSolver.run(startTime, initState, finalTime);
+
+  // The speculative linesearch picks the same step sizes
+  ASSERT_EQ(speculativeSolver.getNumIterations(), serialSolver.getNumIterations());
+  const auto& serialIterationsLog = serialSolver.getIterationsLog();
+  const auto& speculativeIterationsLog = speculativeSolver.getIterationsLog();
+  for (size_t i = 0; i < serialIterationsLog.size(); i++) {
+    ASSERT_NEAR(speculativeIterationsLog[i].merit, serialIterationsLog[i].merit, 1e-9);
+  }
+  const auto serialSolution = serialSolver.primalSolution(finalTime);
+  const auto speculativeSolution = speculativeSolver.primalSolution(finalTime);
+  ASSERT_EQ(speculativeSolution.stateTrajectory_.size(), serialSolution.stateTrajectory_.size());
+  for (size_t i = 0; i < serialSolution.stateTrajectory_.size(); i++) {
+    ASSERT_TRUE(speculativeSolution.stateTrajectory_[i].isApprox(serialSolution.stateTrajectory_[i], 1e-6));
+  }
+
+  // Check constraint satisfaction.
+  const auto performance = speculativeSolver.getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+}
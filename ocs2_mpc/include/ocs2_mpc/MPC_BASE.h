@@ -67,6 +67,12 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Prepares the next run() while waiting for the next observation, e.g., the linearization of a real-time iteration scheme. The MPC
+   * interfaces call it after the policy of run() has been handed over. The default implementation does nothing.
+   */
+  virtual void prepareNextRun() {}
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
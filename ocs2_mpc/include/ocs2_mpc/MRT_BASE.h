@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
@@ -54,6 +55,9 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policies are exchanged through a triple buffer: updatePolicy() never allocates or frees memory, and never blocks unless MRT observers
+ * are registered, such that it can be called from a real-time control loop while a new policy is being published by another thread.
  */
 class MRT_BASE {
  public:
@@ -62,7 +66,7 @@ class MRT_BASE {
   virtual ~MRT_BASE() = default;
 
   /**
-   * Resets the class to its instantiated state.
+   * Resets the class to its instantiated state. This method should not be called concurrently with updatePolicy().
    */
   void reset();
 
@@ -143,6 +147,9 @@ class MRT_BASE {
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
    *
+   * Without MRT observers, this method is wait-free. Otherwise, it waits for a modifyBufferedSolution() call of the observers that
+   * runs in a publishing thread, see MrtObserver. It should always be called from the same thread, and not concurrently with reset().
+   *
    * @return True if the policy is updated.
    */
   bool updatePolicy();
@@ -163,28 +170,34 @@ class MRT_BASE {
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** The MPC output */
+  struct Policy {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+  };
+
+  /**
+   * Calls modifyActiveSolution on all mrt observers while holding the observerMutex_ lock. This function is called from updatePolicy() on
+   * the active policy.
+   */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /**
+   * Calls modifyBufferedSolution on all mrt observers while holding the observerMutex_ lock. This function is called while holding the
+   * publishMutex_ lock.
+   */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
 
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
+  // variables related to the MPC output. The active policy is policyBuffer_.get().
+  TripleBuffer<Policy> policyBuffer_;
 
   // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  std::mutex publishMutex_;   // serializes the producers of the policyBuffer_, the consumer never locks it
+  std::mutex observerMutex_;  // serializes the callbacks of the MRT observers, only locked if there are observers
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
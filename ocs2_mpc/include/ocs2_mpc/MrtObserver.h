@@ -46,7 +46,9 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * The policies are exchanged through a wait-free triple buffer, such that filling of the buffer and the update swapping may run
+ * concurrently. The MRT nevertheless never calls the two callbacks concurrently, it serializes them with a mutex. updatePolicy() is
+ * therefore only wait-free if no observer is registered.
  */
 class MrtObserver {
  public:
@@ -65,8 +67,6 @@ class MrtObserver {
    *
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
-   *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -74,9 +74,8 @@ class MrtObserver {
    * This method is called by the MRT when a new policy is loaded into the buffer.
    * It allows the user to modify the buffered solution before it can be swapped during the updatePolicy call.
    *
-   * When using a multi-threaded MRT, this function does not block the main thread.
-   *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
+   * When using a multi-threaded MRT, this function does not block the main thread, unless the main thread calls updatePolicy() while
+   * this function runs.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
 };
@@ -110,6 +110,9 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
+
+  // prepare the next run while the policy is in use
+  mpc_.prepareNextRun();
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/test/AllocationFreeTest.h>
+
+#include "ocs2_mpc/MRT_BASE.h"
+
+using namespace ocs2;
+
+namespace {
+/** MRT that receives its policies directly through moveToBuffer() */
+class TestMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override {}
+  void setCurrentObservation(const SystemObservation& observation) override {}
+  using MRT_BASE::moveToBuffer;
+};
+}  // unnamed namespace
+
+class MrtAllocations : public AllocationFreeTest {};
+
+TEST_F(MrtAllocations, evaluatePolicy) {
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 4;
+
+  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+  primalSolutionPtr->timeTrajectory_ = {0.0, 0.5, 1.0, 1.5, 2.0};
+  primalSolutionPtr->stateTrajectory_.assign(5, vector_t::Random(stateDim));
+  primalSolutionPtr->inputTrajectory_.assign(5, vector_t::Random(inputDim));
+  primalSolutionPtr->modeSchedule_ = ModeSchedule({1.0}, {0, 1});
+  const matrix_array_t gainTrajectory(5, matrix_t::Random(inputDim, stateDim));
+  primalSolutionPtr->controllerPtr_.reset(
+      new LinearController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_, gainTrajectory));
+
+  TestMrt mrt;
+  mrt.moveToBuffer(std::make_unique<CommandData>(), std::move(primalSolutionPtr), std::make_unique<PerformanceIndex>());
+  ASSERT_TRUE(mrt.updatePolicy());
+
+  const vector_t currentState = vector_t::Random(stateDim);
+  vector_t mpcState(stateDim);
+  vector_t mpcInput(inputDim);
+  size_t mode = 0;
+  scalar_t t = 0.0;
+  EXPECT_ALLOCATION_FREE(mrt.evaluatePolicy(t += 0.01, currentState, mpcState, mpcInput, mode));
+  EXPECT_EQ(mode, 0);
+
+  // Evaluation after the mode switch
+  t = 1.2;
+  EXPECT_ALLOCATION_FREE(mrt.evaluatePolicy(t += 0.01, currentState, mpcState, mpcInput, mode));
+  EXPECT_EQ(mode, 1);
+}
@@ -76,6 +76,7 @@ class MpcnetBehavioralController final : public ControllerBase {
    */
   void setLearnedController(const MpcnetControllerBase& learnedController) { learnedControllerPtr_.reset(learnedController.clone()); }
 
+  using ControllerBase::computeInput;
   vector_t computeInput(scalar_t t, const vector_t& x) override;
   ControllerType getType() const override { return ControllerType::BEHAVIORAL; }
 
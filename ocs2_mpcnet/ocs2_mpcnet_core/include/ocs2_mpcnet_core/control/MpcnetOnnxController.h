@@ -76,6 +76,7 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
 
   void loadPolicyModel(const std::string& policyFilePath) override;
 
+  using ControllerBase::computeInput;
   vector_t computeInput(const scalar_t t, const vector_t& x) override;
   ControllerType getType() const override { return ControllerType::ONNX; }
 
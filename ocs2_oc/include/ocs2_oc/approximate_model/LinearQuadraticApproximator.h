@@ -129,12 +129,29 @@ inline ModelData approximateFinalLQ(OptimalControlProblem& problem, const scalar
  */
 scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input);
 
+/**
+ * Compute the quadratic approximation of the total intermediate cost (i.e. cost + softConstraints). It is assumed that the precomputation
+ * request is already made. The approximation is accumulated in place, so the memory of the output is reused if its size does not change.
+ *
+ * @param [in] problem: The optimal control problem
+ * @param [in] time: The current time.
+ * @param [in] state: The current state.
+ * @param [in] input: The current input.
+ * @param [out] cost: The quadratic approximation of the total intermediate cost.
+ */
+void approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                     ScalarFunctionQuadraticApproximation& cost);
+
 /**
  * Compute the quadratic approximation of the total intermediate cost (i.e. cost + softConstraints). It is assumed that the precomputation
  * request is already made.
  */
-ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
-                                                     const vector_t& input);
+inline ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time,
+                                                            const vector_t& state, const vector_t& input) {
+  ScalarFunctionQuadraticApproximation cost;
+  approximateCost(problem, time, state, input, cost);
+  return cost;
+}
 
 /**
  * Compute the total preJump cost (i.e. cost + softConstraints). It is assumed that the precomputation request is already made.
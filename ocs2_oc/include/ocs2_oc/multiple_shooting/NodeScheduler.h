@@ -0,0 +1,157 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/** Strategies to distribute the nodes of the multiple shooting transcription among the worker threads. */
+enum class NodeSchedulingStrategy {
+  /** Chunks of grainSize consecutive nodes are handed out in order from one shared counter. */
+  DYNAMIC,
+  /** Each worker owns a contiguous block with the same number of nodes. */
+  BLOCK,
+  /** Each worker owns a contiguous block with the same computation time, as measured in the previous pass over the nodes. */
+  COST_AWARE,
+};
+
+namespace node_scheduling {
+
+/**
+ * Get string name of node scheduling strategy
+ * @param strategy: Node scheduling strategy enum
+ */
+std::string toString(NodeSchedulingStrategy strategy);
+
+/**
+ * Get node scheduling strategy from string name, useful for reading config file
+ * @param name: Node scheduling strategy name
+ */
+NodeSchedulingStrategy fromString(const std::string& name);
+
+}  // namespace node_scheduling
+
+/**
+ * Distributes the nodes {0, ..., numNodes-1} of a parallel pass over the horizon among the workers.
+ *
+ * For the BLOCK and COST_AWARE strategies, each worker first processes its own contiguous block in chunks of grainSize nodes, such
+ * that neighbouring nodes (which share the state x[i+1]) stay on the same core and the workers do not contend on a shared counter.
+ * A worker that finishes its block early steals the remaining chunks of the other blocks. For COST_AWARE, the computation time of
+ * every node is measured and the block boundaries of the next pass are chosen such that all blocks take the same time, which
+ * accounts for the more expensive event nodes and constraint-heavy nodes.
+ *
+ * Usage: call reset() outside of the parallel section, then every worker calls forEachNode() inside of it.
+ */
+class NodeScheduler {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] strategy: The scheduling strategy.
+   * @param [in] numWorkers: The number of workers. The worker indices passed to forEachNode() must be in [0, numWorkers).
+   * @param [in] grainSize: The number of consecutive nodes which are claimed at once.
+   */
+  NodeScheduler(NodeSchedulingStrategy strategy, size_t numWorkers, size_t grainSize = 1);
+
+  /**
+   * Prepares the distribution of the nodes for the next parallel pass. Must not be called concurrently with forEachNode().
+   *
+   * @param [in] numNodes: The number of nodes.
+   */
+  void reset(int numNodes);
+
+  /**
+   * Calls the node function for the nodes which are assigned to the calling worker. Every node is processed by exactly one worker.
+   *
+   * @param [in] workerId: The index of the calling worker.
+   * @param [in] nodeFunction: Function with signature void(int nodeIndex).
+   */
+  template <typename NodeFunction>
+  void forEachNode(int workerId, NodeFunction&& nodeFunction);
+
+  /** Gets the scheduling strategy. */
+  NodeSchedulingStrategy getStrategy() const { return strategy_; }
+
+ private:
+  using clock_t = std::chrono::steady_clock;
+
+  /** A contiguous range of nodes owned by one worker, padded to a cache line. */
+  struct Block {
+    std::atomic_int next{0};
+    int end{0};
+    char padding[64 - sizeof(std::atomic_int) - sizeof(int)];
+  };
+
+  /** Claims the next chunk of nodes [begin, end) for the worker. Returns false if all nodes are claimed. */
+  bool claimChunk(int workerId, int& begin, int& end);
+
+  /** Sets the block boundaries such that the blocks have the same measured cost. */
+  void balanceBlocks(int numNodes);
+
+  /** Sets the block boundaries such that the blocks have the same number of nodes. */
+  void splitEvenly(int numNodes);
+
+  /** Assigns the nodes [begin, end) to the block. */
+  void setBlock(int blockIndex, int begin, int end);
+
+  const NodeSchedulingStrategy strategy_;
+  const int grainSize_;
+  std::vector<Block> blocks_;
+  std::vector<scalar_t> nodeCost_;  // smoothed computation time per node [s], only used by COST_AWARE
+};
+
+template <typename NodeFunction>
+void NodeScheduler::forEachNode(int workerId, NodeFunction&& nodeFunction) {
+  const bool measureCost = strategy_ == NodeSchedulingStrategy::COST_AWARE;
+  int begin, end;
+  while (claimChunk(workerId, begin, end)) {
+    for (int i = begin; i < end; ++i) {
+      if (measureCost) {
+        const auto start = clock_t::now();
+        nodeFunction(i);
+        const std::chrono::duration<scalar_t> duration = clock_t::now() - start;
+        nodeCost_[i] = 0.5 * (nodeCost_[i] + duration.count());
+      } else {
+        nodeFunction(i);
+      }
+    }
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -0,0 +1,217 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
+
+#include "ocs2_oc/multiple_shooting/NodeScheduler.h"
+#include "ocs2_oc/oc_data/PerformanceIndex.h"
+#include "ocs2_oc/search_strategy/FilterLinesearch.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Evaluates several step sizes of a backtracking filter linesearch concurrently.
+ *
+ * The work items are the (candidate, node) pairs in candidate-major order, such that the workers of a team first finish the larger
+ * step sizes. With the BLOCK and COST_AWARE strategies, this splits the team into groups of workers, each evaluating one candidate.
+ * As soon as a candidate is accepted, the nodes of all smaller step sizes are skipped, while the larger step sizes which are still in
+ * flight are completed. The returned step size is therefore the same as the one of a serial backtracking over the candidates.
+ */
+class SpeculativeLinesearch {
+ public:
+  /** The evaluation of a step size */
+  struct Candidate {
+    scalar_t stepSize = 0.0;
+    bool evaluated = false;  // false if the evaluation was cancelled
+    bool accepted = false;
+    FilterLinesearch::StepType stepType = FilterLinesearch::StepType::UNKNOWN;
+    PerformanceIndex performance;
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] strategy: The scheduling strategy of the (candidate, node) pairs.
+   * @param [in] numWorkers: The number of workers.
+   * @param [in] grainSize: The number of consecutive nodes which are claimed at once.
+   */
+  SpeculativeLinesearch(NodeSchedulingStrategy strategy, size_t numWorkers, size_t grainSize = 1);
+
+  /**
+   * Evaluates the step sizes in parallel and checks their acceptance.
+   *
+   * @param [in] workerTeam: The worker team. Its size must not exceed the number of workers given in the constructor.
+   * @param [in] filterLinesearch: The step acceptance criteria.
+   * @param [in] baseline: The zero step PerformanceIndex.
+   * @param [in] armijoDescentMetric: The Armijo descent metric of the full step.
+   * @param [in] stepSizes: The step sizes in decreasing order.
+   * @param [in] numNodes: The number of nodes of the transcription.
+   * @param [in] nodeFunction: Function with signature PerformanceIndex(int workerId, int candidateIndex, int nodeIndex) which evaluates
+   *                           a node for the given step size. The merit of the returned performance is ignored.
+   * @return The index of the largest accepted step size, or -1 if none of the step sizes is accepted.
+   */
+  template <typename NodeFunction>
+  int run(WorkerTeam& workerTeam, const FilterLinesearch& filterLinesearch, const PerformanceIndex& baseline, scalar_t armijoDescentMetric,
+          const scalar_array_t& stepSizes, int numNodes, NodeFunction&& nodeFunction);
+
+  /**
+   * Runs the backtracking filter linesearch of the multiple shooting solvers over the given step sizes. The step sizes are evaluated in
+   * batches of batchSize candidates through run(), until one of them is accepted. The candidates of a batch are stored in the slots
+   * [0, batchSize) of the caller, hence the slot of a candidate equals its index in getCandidates().
+   *
+   * @param [in] workerTeam: The worker team. Its size must not exceed the number of workers given in the constructor.
+   * @param [in] filterLinesearch: The step acceptance criteria.
+   * @param [in] baseline: The zero step PerformanceIndex.
+   * @param [in] armijoDescentMetric: The Armijo descent metric of the full step.
+   * @param [in] stepSizes: The step sizes in decreasing order, see getStepSizes().
+   * @param [in] batchSize: The number of step sizes which are evaluated concurrently.
+   * @param [in] numNodes: The number of nodes of the transcription.
+   * @param [in] setCandidate: Function with signature void(int slot, scalar_t stepSize) which computes the iterate of the given step size
+   *                           into the given slot.
+   * @param [in] nodeFunction: Function with signature PerformanceIndex(int workerId, int slot, int nodeIndex), see run().
+   * @param [in] printLinesearch: Whether to print the evaluated candidates.
+   * @param [in] deltaXnorm: The norm of the full state step, only used for printing.
+   * @param [in] deltaUnorm: The norm of the full input step, only used for printing.
+   * @return The slot of the accepted step size, or -1 if none of the step sizes is accepted.
+   */
+  template <typename SetCandidate, typename NodeFunction>
+  int backtrack(WorkerTeam& workerTeam, const FilterLinesearch& filterLinesearch, const PerformanceIndex& baseline,
+                scalar_t armijoDescentMetric, const scalar_array_t& stepSizes, size_t batchSize, int numNodes, SetCandidate&& setCandidate,
+                NodeFunction&& nodeFunction, bool printLinesearch, scalar_t deltaXnorm, scalar_t deltaUnorm);
+
+  /** Gets the candidates of the last run in decreasing order of the step size. */
+  const std::vector<Candidate>& getCandidates() const { return candidates_; }
+
+  /**
+   * Gets the step sizes of a serial backtracking, which starts at maxStepSize and stops at alphaMin or when the primal steps become
+   * smaller than deltaTol.
+   */
+  static scalar_array_t getStepSizes(scalar_t maxStepSize, scalar_t alphaDecay, scalar_t alphaMin, scalar_t deltaTol, scalar_t deltaXnorm,
+                                     scalar_t deltaUnorm);
+
+ private:
+  /** Resets the candidates and the counters before a run. */
+  void reset(const scalar_array_t& stepSizes, int numNodes);
+
+  /** Prints the candidates of the last run up to the accepted one. */
+  void printCandidates(int accepted, scalar_t deltaXnorm, scalar_t deltaUnorm) const;
+
+  /** Sums the performance of the workers and checks the acceptance of a fully evaluated candidate. */
+  void finalizeCandidate(int candidateIndex, const FilterLinesearch& filterLinesearch, const PerformanceIndex& baseline,
+                         scalar_t armijoDescentMetric);
+
+  const size_t numWorkers_;
+  NodeScheduler scheduler_;
+  std::vector<Candidate> candidates_;
+  std::vector<PerformanceIndex> workerPerformance_;  // [candidateIndex * numWorkers_ + workerId]
+  std::unique_ptr<std::atomic_int[]> remainingNodes_;
+  size_t remainingNodesCapacity_{0};
+  std::atomic_int firstAccepted_{0};
+};
+
+template <typename NodeFunction>
+int SpeculativeLinesearch::run(WorkerTeam& workerTeam, const FilterLinesearch& filterLinesearch, const PerformanceIndex& baseline,
+                               scalar_t armijoDescentMetric, const scalar_array_t& stepSizes, int numNodes, NodeFunction&& nodeFunction) {
+  reset(stepSizes, numNodes);
+  const int numCandidates = static_cast<int>(stepSizes.size());
+
+  scheduler_.reset(numCandidates * numNodes);
+  workerTeam.run([&](int workerId) {
+    scheduler_.forEachNode(workerId, [&](int item) {
+      const int candidateIndex = item / numNodes;
+      // Skip the step sizes which are smaller than an accepted one
+      if (candidateIndex > firstAccepted_.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      workerPerformance_[candidateIndex * numWorkers_ + workerId] += nodeFunction(workerId, candidateIndex, item % numNodes);
+
+      // The last worker to finish a node of the candidate checks its acceptance
+      if (remainingNodes_[candidateIndex].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        finalizeCandidate(candidateIndex, filterLinesearch, baseline, armijoDescentMetric);
+      }
+    });
+  });
+
+  const int firstAccepted = firstAccepted_.load();
+  return (firstAccepted < numCandidates) ? firstAccepted : -1;
+}
+
+template <typename SetCandidate, typename NodeFunction>
+int SpeculativeLinesearch::backtrack(WorkerTeam& workerTeam, const FilterLinesearch& filterLinesearch, const PerformanceIndex& baseline,
+                                     scalar_t armijoDescentMetric, const scalar_array_t& stepSizes, size_t batchSize, int numNodes,
+                                     SetCandidate&& setCandidate, NodeFunction&& nodeFunction, bool printLinesearch, scalar_t deltaXnorm,
+                                     scalar_t deltaUnorm) {
+  if (printLinesearch) {
+    std::cerr << std::setprecision(9) << std::fixed;
+    std::cerr << "\n=== Speculative linesearch ===\n";
+    std::cerr << "Baseline:\n" << baseline << "\n";
+  }
+
+  batchSize = std::max(batchSize, size_t(1));
+  scalar_array_t batchStepSizes;
+  batchStepSizes.reserve(batchSize);
+  for (size_t batchBegin = 0; batchBegin < stepSizes.size(); batchBegin += batchSize) {
+    const size_t batchEnd = std::min(batchBegin + batchSize, stepSizes.size());
+    batchStepSizes.assign(stepSizes.begin() + batchBegin, stepSizes.begin() + batchEnd);
+
+    // Compute steps
+    for (size_t c = 0; c < batchStepSizes.size(); ++c) {
+      setCandidate(static_cast<int>(c), batchStepSizes[c]);
+    }
+
+    // Compute cost and constraints of all steps, and their acceptance
+    const int accepted = run(workerTeam, filterLinesearch, baseline, armijoDescentMetric, batchStepSizes, numNodes, nodeFunction);
+
+    if (printLinesearch) {
+      printCandidates(accepted, deltaXnorm, deltaUnorm);
+    }
+
+    if (accepted >= 0) {
+      return accepted;
+    }
+  }
+
+  return -1;
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
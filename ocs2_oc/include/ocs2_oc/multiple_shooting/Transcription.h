@@ -63,6 +63,22 @@ struct Transcription {
   ProjectionMultiplierCoefficients projectionMultiplierCoefficients;
 };
 
+/**
+ * Compute the multiple shooting transcription for a single intermediate node in place. All members of the transcription are
+ * overwritten. When the transcription of a node is kept across iterations, the memory of the cost is reused.
+ *
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param sensitivityDiscretizer : Integrator to use for creating the discrete dynamics.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param x_next : State at the end of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @param [out] transcription : multiple shooting transcription for this node.
+ */
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t,
+                           scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription);
+
 /**
  * Compute the multiple shooting transcription for a single intermediate node.
  *
@@ -75,8 +91,31 @@ struct Transcription {
  * @param u : Input, taken to be constant across the interval.
  * @return multiple shooting transcription for this node.
  */
-Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+inline Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem,
+                                           DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t, scalar_t dt,
+                                           const vector_t& x, const vector_t& x_next, const vector_t& u) {
+  Transcription transcription;
+  setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  return transcription;
+}
+
+/**
+ * Updates an unprojected intermediate node transcription, computed at another point, to the point {x, x_next, u} without evaluating the
+ * sensitivities of the dynamics and constraints. The dynamics, cost, and constraint values as well as the cost gradient are evaluated at
+ * the new point. The cost Hessian and all other sensitivities are kept. The projection is cleared.
+ *
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param discretizer : Integrator to use for creating the discrete dynamics.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param x_next : State at the end of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @param [in, out] transcription : multiple shooting transcription for this node.
+ */
+void updateIntermediateNodeResiduals(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t,
+                                     scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                     Transcription& transcription);
 
 /**
  * Apply the state-input equality constraint projection for a single intermediate node transcription.
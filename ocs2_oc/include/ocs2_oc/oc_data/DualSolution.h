@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/model_data/Multiplier.h>
 
 namespace ocs2 {
@@ -106,6 +107,20 @@ inline MultiplierCollection getIntermediateDualSolutionAtTime(const DualSolution
   return LinearInterpolation::interpolate(indexAlpha, dualSolution.intermediates);
 }
 
+/**
+ * Same as getIntermediateDualSolutionAtTime(dualSolution, time), with a cursor that speeds up sequential lookups.
+ *
+ * @param [in] dualSolution: The dual solution
+ * @param [in] time: The inquiry time
+ * @param [in, out] cursor: The time segment cursor of the previous lookup in dualSolution.
+ * @return The collection of multipliers associated to state/state-input, equality/inequality Lagrangian terms.
+ */
+inline MultiplierCollection getIntermediateDualSolutionAtTime(const DualSolution& dualSolution, scalar_t time,
+                                                              LinearInterpolation::TimeSegmentCursor& cursor) {
+  const auto indexAlpha = cursor.timeSegment(time, dualSolution.timeTrajectory);
+  return LinearInterpolation::interpolate(indexAlpha, dualSolution.intermediates);
+}
+
 /**
  * Samples the intermediate dual solution at the given time array.
  *
@@ -118,8 +133,9 @@ inline void sampleIntermediateDualSolution(const DualSolution& dualSolution, con
   // re-sample dual solution
   intermediateDualSolution.clear();
   intermediateDualSolution.reserve(timeTrajectory.size());
+  LinearInterpolation::TimeSegmentCursor cursor;
   for (const auto& t : timeTrajectory) {
-    intermediateDualSolution.push_back(getIntermediateDualSolutionAtTime(dualSolution, t));
+    intermediateDualSolution.push_back(getIntermediateDualSolutionAtTime(dualSolution, t, cursor));
   }
 }
 
@@ -102,6 +102,17 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution);
 
+  /**
+   * Prepares the next call of run() ahead of time, e.g., the linearization of a real-time iteration scheme. As in run(), the
+   * ReferenceManager and the synchronized modules are updated first for the given horizon. Solvers without a preparation phase do
+   * nothing else.
+   *
+   * @param [in] initTime: The expected initial time of the next run().
+   * @param [in] initState: A guess of the initial state of the next run().
+   * @param [in] finalTime: The expected final time of the next run().
+   */
+  void prepareRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -259,6 +270,8 @@ class SolverBase {
 
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) = 0;
 
+  virtual void prepareRunImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {}
+
   void preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
 
   void postRun();
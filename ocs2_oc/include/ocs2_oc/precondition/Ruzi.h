@@ -32,7 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Sparse>
 
 #include <ocs2_core/Types.h>
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 
 #include "ocs2_oc/oc_problem/OcpSize.h"
 
@@ -76,7 +76,7 @@ namespace precondition {
  *       *   *   *    Cn  Dn  0]
  * g = [(A0 x0 + b0); b1; ...; bn, -(C0 x0 + e0); -e1; ...; en]
  *
- * @param [in] threadPool : The external thread pool.
+ * @param [in] workerTeam : The external worker team.
  * @param [in] x0 : The initial state.
  * @param [in] ocpSize : The size of the oc problem.
  * @param [in] iteration : Number of iterations.
@@ -89,7 +89,7 @@ namespace precondition {
  *                               of this type of matrix for every timestamp.
  * @param [out] cOut : Scaling factor c.
  */
-void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
+void ocpDataInPlaceInParallel(WorkerTeam& workerTeam, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
                               std::vector<VectorFunctionLinearApproximation>& dynamics,
                               std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
                               vector_array_t& scalingVectors, scalar_t& cOut);
@@ -54,7 +54,7 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
   modelData.dynamicsBias.setZero(modelData.dynamics.dfdx.rows());
 
   // Cost
-  modelData.cost = ocs2::approximateCost(problem, time, state, input);
+  ocs2::approximateCost(problem, time, state, input, modelData.cost);
 
   // Equality constraints
   modelData.stateEqConstraint = problem.stateEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -97,6 +97,7 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
   modelData.inputDim = 0;
 
   // Jump map
+  modelData.dynamicsCovariance = matrix_t();
   modelData.dynamics = problem.dynamicsPtr->jumpMapLinearApproximation(time, state, preComputation);
   modelData.dynamicsBias.setZero(modelData.dynamics.dfdx.rows());
 
@@ -105,6 +106,7 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
 
   // state equality constraint
   modelData.stateEqConstraint = problem.preJumpEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
+  modelData.stateInputEqConstraint = VectorFunctionLinearApproximation();
 
   // Lagrangians
   if (!problem.preJumpEqualityLagrangianPtr->empty()) {
@@ -136,10 +138,12 @@ void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, co
   modelData.dynamicsBias = vector_t();
 
   // Dynamics
+  modelData.dynamicsCovariance = matrix_t();
   modelData.dynamics = VectorFunctionLinearApproximation();
 
   // state equality constraint
   modelData.stateEqConstraint = problem.finalEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
+  modelData.stateInputEqConstraint = VectorFunctionLinearApproximation();
 
   // Final cost
   modelData.cost = approximateFinalCost(problem, time, state);
@@ -178,13 +182,14 @@ scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time,
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
-                                                     const vector_t& input) {
+void approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                     ScalarFunctionQuadraticApproximation& cost) {
   const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
   const auto& preComputation = *problem.preComputationPtr;
 
   // get the state-input cost approximations
-  auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+  cost.setZero(state.rows(), input.rows());
+  cost += problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
 
   if (!problem.softConstraintPtr->empty()) {
     cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
@@ -204,8 +209,6 @@ ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem
     cost.dfdx += stateCost.dfdx;
     cost.dfdxx += stateCost.dfdxx;
   }
-
-  return cost;
 }
 
 /******************************************************************************************************/
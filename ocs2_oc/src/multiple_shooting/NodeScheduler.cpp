@@ -0,0 +1,146 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/NodeScheduler.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace node_scheduling {
+
+std::string toString(NodeSchedulingStrategy strategy) {
+  static const std::unordered_map<NodeSchedulingStrategy, std::string> strategyMap = {
+      {NodeSchedulingStrategy::DYNAMIC, "DYNAMIC"},
+      {NodeSchedulingStrategy::BLOCK, "BLOCK"},
+      {NodeSchedulingStrategy::COST_AWARE, "COST_AWARE"}};
+
+  return strategyMap.at(strategy);
+}
+
+NodeSchedulingStrategy fromString(const std::string& name) {
+  static const std::unordered_map<std::string, NodeSchedulingStrategy> strategyMap = {
+      {"DYNAMIC", NodeSchedulingStrategy::DYNAMIC},
+      {"BLOCK", NodeSchedulingStrategy::BLOCK},
+      {"COST_AWARE", NodeSchedulingStrategy::COST_AWARE}};
+
+  return strategyMap.at(name);
+}
+
+}  // namespace node_scheduling
+
+NodeScheduler::NodeScheduler(NodeSchedulingStrategy strategy, size_t numWorkers, size_t grainSize)
+    : strategy_(strategy), grainSize_(static_cast<int>(std::max(grainSize, size_t(1)))), blocks_(std::max(numWorkers, size_t(1))) {}
+
+void NodeScheduler::reset(int numNodes) {
+  const int numBlocks = blocks_.size();
+  switch (strategy_) {
+    case NodeSchedulingStrategy::DYNAMIC: {
+      // All nodes in the first block, which is then shared by all workers
+      setBlock(0, 0, numNodes);
+      for (int w = 1; w < numBlocks; ++w) {
+        setBlock(w, numNodes, numNodes);
+      }
+      break;
+    }
+    case NodeSchedulingStrategy::BLOCK: {
+      splitEvenly(numNodes);
+      break;
+    }
+    case NodeSchedulingStrategy::COST_AWARE: {
+      balanceBlocks(numNodes);
+      break;
+    }
+    default:
+      throw std::runtime_error("[NodeScheduler::reset] Unknown node scheduling strategy!");
+  }
+}
+
+void NodeScheduler::balanceBlocks(int numNodes) {
+  const int numBlocks = blocks_.size();
+
+  // Nodes which have not been measured yet (e.g., the horizon has grown) are assumed to have the average cost.
+  if (nodeCost_.size() != static_cast<size_t>(numNodes)) {
+    const scalar_t averageCost = nodeCost_.empty() ? 0.0 : std::accumulate(nodeCost_.begin(), nodeCost_.end(), 0.0) / nodeCost_.size();
+    nodeCost_.resize(numNodes, averageCost);
+  }
+
+  const scalar_t totalCost = std::accumulate(nodeCost_.begin(), nodeCost_.end(), 0.0);
+  if (totalCost <= 0.0) {  // nothing measured yet
+    splitEvenly(numNodes);
+    return;
+  }
+
+  // A node is assigned to the block in which the midpoint of its cost lies.
+  int i = 0;
+  scalar_t accumulatedCost = 0.0;
+  for (int w = 0; w < numBlocks; ++w) {
+    const int begin = i;
+    const scalar_t targetCost = totalCost * (w + 1) / numBlocks;
+    while (i < numNodes && (w == numBlocks - 1 || accumulatedCost + 0.5 * nodeCost_[i] < targetCost)) {
+      accumulatedCost += nodeCost_[i];
+      ++i;
+    }
+    setBlock(w, begin, i);
+  }
+}
+
+void NodeScheduler::splitEvenly(int numNodes) {
+  const int numBlocks = blocks_.size();
+  for (int w = 0; w < numBlocks; ++w) {
+    setBlock(w, w * numNodes / numBlocks, (w + 1) * numNodes / numBlocks);
+  }
+}
+
+void NodeScheduler::setBlock(int blockIndex, int begin, int end) {
+  blocks_[blockIndex].next.store(begin, std::memory_order_relaxed);
+  blocks_[blockIndex].end = end;
+}
+
+bool NodeScheduler::claimChunk(int workerId, int& begin, int& end) {
+  // Start with the own block, then help the others
+  const int numBlocks = blocks_.size();
+  for (int k = 0; k < numBlocks; ++k) {
+    Block& block = blocks_[(workerId + k) % numBlocks];
+    if (block.next.load(std::memory_order_relaxed) < block.end) {
+      begin = block.next.fetch_add(grainSize_, std::memory_order_relaxed);
+      if (begin < block.end) {
+        end = std::min(begin + grainSize_, block.end);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_oc/multiple_shooting/SpeculativeLinesearch.h"
+
+#include <numeric>
+#include <tuple>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+SpeculativeLinesearch::SpeculativeLinesearch(NodeSchedulingStrategy strategy, size_t numWorkers, size_t grainSize)
+    : numWorkers_(std::max(numWorkers, size_t(1))), scheduler_(strategy, numWorkers_, grainSize) {}
+
+void SpeculativeLinesearch::reset(const scalar_array_t& stepSizes, int numNodes) {
+  const size_t numCandidates = stepSizes.size();
+
+  candidates_.resize(numCandidates);
+  for (size_t c = 0; c < numCandidates; ++c) {
+    candidates_[c] = Candidate();
+    candidates_[c].stepSize = stepSizes[c];
+  }
+
+  workerPerformance_.assign(numCandidates * numWorkers_, PerformanceIndex());
+
+  if (remainingNodesCapacity_ < numCandidates) {
+    remainingNodes_.reset(new std::atomic_int[numCandidates]);
+    remainingNodesCapacity_ = numCandidates;
+  }
+  for (size_t c = 0; c < numCandidates; ++c) {
+    remainingNodes_[c].store(numNodes, std::memory_order_relaxed);
+  }
+
+  firstAccepted_.store(static_cast<int>(numCandidates), std::memory_order_relaxed);
+}
+
+scalar_array_t SpeculativeLinesearch::getStepSizes(scalar_t maxStepSize, scalar_t alphaDecay, scalar_t alphaMin, scalar_t deltaTol,
+                                                   scalar_t deltaXnorm, scalar_t deltaUnorm) {
+  scalar_array_t stepSizes{maxStepSize};
+  while (true) {
+    const scalar_t alpha = stepSizes.back() * alphaDecay;
+    if (alpha < alphaMin || (alpha * deltaXnorm < deltaTol && alpha * deltaUnorm < deltaTol)) {
+      break;
+    }
+    stepSizes.push_back(alpha);
+  }
+  return stepSizes;
+}
+
+void SpeculativeLinesearch::printCandidates(int accepted, scalar_t deltaXnorm, scalar_t deltaUnorm) const {
+  const size_t numPrinted = (accepted < 0) ? candidates_.size() : accepted + 1;
+  for (size_t c = 0; c < numPrinted; ++c) {
+    const auto& candidate = candidates_[c];
+    std::cerr << "Step size: " << candidate.stepSize << ", Step Type: " << toString(candidate.stepType)
+              << (candidate.accepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+    std::cerr << "|dx| = " << candidate.stepSize * deltaXnorm << "\t|du| = " << candidate.stepSize * deltaUnorm << "\n";
+    std::cerr << candidate.performance << "\n";
+  }
+}
+
+void SpeculativeLinesearch::finalizeCandidate(int candidateIndex, const FilterLinesearch& filterLinesearch, const PerformanceIndex& baseline,
+                                              scalar_t armijoDescentMetric) {
+  auto& candidate = candidates_[candidateIndex];
+
+  const auto workerBegin = workerPerformance_.begin() + candidateIndex * numWorkers_;
+  candidate.performance = std::accumulate(std::next(workerBegin), workerBegin + numWorkers_, *workerBegin);
+  candidate.performance.merit =
+      candidate.performance.cost + candidate.performance.equalityLagrangian + candidate.performance.inequalityLagrangian;
+
+  std::tie(candidate.accepted, candidate.stepType) =
+      filterLinesearch.acceptStep(baseline, candidate.performance, candidate.stepSize * armijoDescentMetric);
+  candidate.evaluated = true;
+
+  // Lower the index of the first accepted candidate, which cancels the evaluation of the smaller step sizes
+  if (candidate.accepted) {
+    int firstAccepted = firstAccepted_.load();
+    while (candidateIndex < firstAccepted && !firstAccepted_.compare_exchange_weak(firstAccepted, candidateIndex)) {
+    }
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -33,14 +33,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
 #include "ocs2_oc/approximate_model/LinearQuadraticApproximator.h"
+#include "ocs2_oc/multiple_shooting/MetricsComputation.h"
 
 namespace ocs2 {
 namespace multiple_shooting {
 
-Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t,
+                           scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription) {
   // Results and short-hand notation
-  Transcription transcription;
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
@@ -59,7 +59,7 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
 
   // Costs: Approximate the integral with forward euler
-  cost = approximateCost(optimalControlProblem, t, x, u);
+  approximateCost(optimalControlProblem, t, x, u, cost);
   cost *= dt;
 
   // State equality constraints
@@ -67,6 +67,9 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateEq = optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t);
     stateEqConstraints =
         optimalControlProblem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    stateEqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State-input equality constraints
@@ -74,6 +77,9 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateInputEq = optimalControlProblem.equalityConstraintPtr->getTermsSize(t);
     stateInputEqConstraints =
         optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateInputEq.clear();
+    stateInputEqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
@@ -81,6 +87,9 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateIneq = optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t);
     stateIneqConstraints =
         optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    stateIneqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State-input inequality constraints.
@@ -88,9 +97,45 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateInputIneq = optimalControlProblem.inequalityConstraintPtr->getTermsSize(t);
     stateInputIneqConstraints =
         optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateInputIneq.clear();
+    stateInputIneqConstraints = VectorFunctionLinearApproximation();
   }
 
-  return transcription;
+  // The projection is only set by projectTranscription
+  transcription.constraintsProjection = VectorFunctionLinearApproximation();
+  transcription.projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
+}
+
+void updateIntermediateNodeResiduals(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t,
+                                     scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                     Transcription& transcription) {
+  // Dynamics
+  transcription.dynamics.f = discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  transcription.dynamics.f -= x_next;
+
+  // Precomputation for other terms, with the approximation for the cost gradient
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
+  optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  const auto metrics = computeIntermediateMetrics(optimalControlProblem, t, x, u);
+
+  // Costs: value and gradient at the new point, the Hessian of the transcription is kept
+  thread_local ScalarFunctionQuadraticApproximation costApproximation;
+  approximateCost(optimalControlProblem, t, x, u, costApproximation);
+  auto& cost = transcription.cost;
+  cost.f = dt * costApproximation.f;
+  cost.dfdx = dt * costApproximation.dfdx;
+  cost.dfdu = dt * costApproximation.dfdu;
+
+  // Constraints
+  transcription.stateEqConstraints.f = toVector(metrics.stateEqConstraint);
+  transcription.stateInputEqConstraints.f = toVector(metrics.stateInputEqConstraint);
+  transcription.stateIneqConstraints.f = toVector(metrics.stateIneqConstraint);
+  transcription.stateInputIneqConstraints.f = toVector(metrics.stateInputIneqConstraint);
+
+  // The projection is only set by projectTranscription
+  transcription.constraintsProjection = VectorFunctionLinearApproximation();
+  transcription.projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
@@ -47,9 +47,25 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints) {
+  OcpSize problemSize;
+  extractSizesFromProblem(dynamics, cost, constraints, problemSize);
+  return problemSize;
+}
+
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints, OcpSize& problemSize) {
   const int numStages = dynamics.size();
 
-  OcpSize problemSize(dynamics.size());
+  problemSize.numStages = numStages;
+  problemSize.numInputs.assign(numStages + 1, 0);
+  problemSize.numStates.assign(numStages + 1, 0);
+  problemSize.numInputBoxConstraints.assign(numStages + 1, 0);
+  problemSize.numStateBoxConstraints.assign(numStages + 1, 0);
+  problemSize.numIneqConstraints.assign(numStages + 1, 0);
+  problemSize.numInputBoxSlack.assign(numStages + 1, 0);
+  problemSize.numStateBoxSlack.assign(numStages + 1, 0);
+  problemSize.numIneqSlack.assign(numStages + 1, 0);
 
   // State inputs
   for (int k = 0; k < numStages; k++) {
@@ -65,8 +81,6 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
       problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
     }
   }
-
-  return problemSize;
 }
 
 }  // namespace ocs2
\ No newline at end of file
@@ -75,11 +75,12 @@ void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSoluti
 
   // intermediates
   dualSolution.intermediates.resize(primalSolution.timeTrajectory_.size());
+  LinearInterpolation::TimeSegmentCursor cursor;
   for (size_t i = 0; i < primalSolution.timeTrajectory_.size(); i++) {
     const auto& time = primalSolution.timeTrajectory_[i];
     auto& multipliers = dualSolution.intermediates[i];
     if (interpolatableTimePeriod.first <= time && time <= interpolatableTimePeriod.second) {
-      multipliers = getIntermediateDualSolutionAtTime(cachedDualSolution, time);
+      multipliers = getIntermediateDualSolutionAtTime(cachedDualSolution, time, cursor);
     } else {
       initializeIntermediateMultiplierCollection(ocp, time, multipliers);
     }
@@ -70,6 +70,14 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
   postRun();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::prepareRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  preRun(initTime, initState, finalTime);
+  prepareRunImpl(initTime, initState, finalTime);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
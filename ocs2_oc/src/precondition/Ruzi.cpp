@@ -101,7 +101,7 @@ void scaleMatrixInPlace(const vector_t* rowScale, const vector_t* colScale, Eige
   }
 }
 
-void invSqrtInfNormInParallel(ThreadPool& threadPool, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+void invSqrtInfNormInParallel(WorkerTeam& workerTeam, const std::vector<VectorFunctionLinearApproximation>& dynamics,
                               const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& scalingVectors,
                               vector_array_t& D, vector_array_t& E) {
   // Helper function
@@ -124,12 +124,12 @@ void invSqrtInfNormInParallel(ThreadPool& threadPool, const std::vector<VectorFu
       E[k] = invSqrt(matrixInfNormRows(dynamics[k].dfdx, dynamics[k].dfdu, scalingVectors[k]));
     }
   };
-  threadPool.runParallel(std::move(task), threadPool.numThreads() + 1U);
+  workerTeam.run(task);
 
   D[2 * N - 1] = invSqrt(matrixInfNormCols(cost[N].dfdxx, scalingVectors[N - 1].transpose().eval()));
 }
 
-void scaleDataOneStepInPlaceInParallel(ThreadPool& threadPool, const vector_array_t& D, const vector_array_t& E,
+void scaleDataOneStepInPlaceInParallel(WorkerTeam& workerTeam, const vector_array_t& D, const vector_array_t& E,
                                        std::vector<VectorFunctionLinearApproximation>& dynamics,
                                        std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<vector_t>& scalingVectors) {
   // cost at 0
@@ -168,7 +168,7 @@ void scaleDataOneStepInPlaceInParallel(ThreadPool& threadPool, const vector_arra
       }
     }
   };
-  threadPool.runParallel(std::move(scaleCostConstraints), threadPool.numThreads() + 1U);
+  workerTeam.run(scaleCostConstraints);
 }
 
 vector_t matrixInfNormRows(const Eigen::SparseMatrix<scalar_t>& mat) {
@@ -207,7 +207,7 @@ void scaleMatrixInPlace(const vector_t& rowScale, const vector_t& colScale, Eige
 
 }  // anonymous namespace
 
-void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
+void ocpDataInPlaceInParallel(WorkerTeam& workerTeam, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
                               std::vector<VectorFunctionLinearApproximation>& dynamics,
                               std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
                               vector_array_t& scalingVectors, scalar_t& cOut) {
@@ -233,10 +233,10 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
 
   vector_array_t D(2 * N), E(N);
   std::atomic_int timeIndex{0};
-  const size_t numWorkers = threadPool.numThreads() + 1U;
+  const size_t numWorkers = workerTeam.size();
   for (int i = 0; i < iteration; i++) {
-    invSqrtInfNormInParallel(threadPool, dynamics, cost, scalingVectors, D, E);
-    scaleDataOneStepInPlaceInParallel(threadPool, D, E, dynamics, cost, scalingVectors);
+    invSqrtInfNormInParallel(workerTeam, dynamics, cost, scalingVectors, D, E);
+    scaleDataOneStepInPlaceInParallel(workerTeam, D, E, dynamics, cost, scalingVectors);
 
     timeIndex = 0;
     scalar_array_t infNormOfhArray(numWorkers, 0.0);
@@ -263,7 +263,7 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
       infNormOfhArray[workerId] = std::max(infNormOfhArray[workerId], workerInfNormOfh);
       sumOfInfNormOfHArray[workerId] += workerSumOfInfNormOfH;
     };
-    threadPool.runParallel(std::move(infNormOfh_sumOfInfNormOfH), numWorkers);
+    workerTeam.run(infNormOfh_sumOfInfNormOfH);
 
     const auto infNormOfh = *std::max_element(infNormOfhArray.cbegin(), infNormOfhArray.cend());
     const auto sumOfInfNormOfH = std::accumulate(sumOfInfNormOfHArray.cbegin(), sumOfInfNormOfHArray.cend(), 0.0);
@@ -295,7 +295,7 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
         cost[N].dfdu *= gamma;
       }
     };
-    threadPool.runParallel(std::move(computeDOutEOutScaleCost), numWorkers);
+    workerTeam.run(computeDOutEOutScaleCost);
 
     // compute cOut
     cOut *= gamma;
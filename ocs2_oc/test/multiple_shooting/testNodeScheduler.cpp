@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+
+#include <ocs2_core/thread_support/WorkerTeam.h>
+#include <ocs2_oc/multiple_shooting/NodeScheduler.h>
+
+using namespace ocs2;
+using namespace multiple_shooting;
+
+namespace {
+void busyWait(std::chrono::microseconds duration) {
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < duration) {
+  }
+}
+}  // unnamed namespace
+
+TEST(testNodeScheduler, testEveryNodeOnce) {
+  constexpr size_t numWorkers = 3;
+  WorkerTeam workerTeam(numWorkers);
+
+  for (const auto strategy : {NodeSchedulingStrategy::DYNAMIC, NodeSchedulingStrategy::BLOCK, NodeSchedulingStrategy::COST_AWARE}) {
+    for (const size_t grainSize : {1, 4}) {
+      NodeScheduler scheduler(strategy, numWorkers, grainSize);
+      for (const int numNodes : {0, 1, 2, 25, 26}) {
+        std::vector<std::atomic_int> counter(numNodes);
+        for (auto& c : counter) {
+          c = 0;
+        }
+
+        scheduler.reset(numNodes);
+        workerTeam.run([&](int workerId) { scheduler.forEachNode(workerId, [&](int i) { counter[i]++; }); });
+
+        for (int i = 0; i < numNodes; ++i) {
+          EXPECT_EQ(counter[i], 1) << "strategy: " << node_scheduling::toString(strategy) << ", grainSize: " << grainSize
+                                   << ", numNodes: " << numNodes << ", node: " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(testNodeScheduler, testContiguousBlocks) {
+  constexpr int numNodes = 10;
+  NodeScheduler scheduler(NodeSchedulingStrategy::BLOCK, 2);
+  scheduler.reset(numNodes);
+
+  // A single worker first processes its own block, then steals the rest
+  std::vector<int> visited;
+  scheduler.forEachNode(1, [&](int i) { visited.push_back(i); });
+  const std::vector<int> expected{5, 6, 7, 8, 9, 0, 1, 2, 3, 4};
+  EXPECT_EQ(visited, expected);
+}
+
+TEST(testNodeScheduler, testCostAwareBlocks) {
+  constexpr int numNodes = 11;
+  NodeScheduler scheduler(NodeSchedulingStrategy::COST_AWARE, 2);
+
+  // The first node costs twice as much as all the others together
+  auto nodeFunction = [](int i) { busyWait(std::chrono::microseconds(i == 0 ? 4000 : 200)); };
+
+  scheduler.reset(numNodes);
+  int firstNodeOfSecondWorker = -1;
+  scheduler.forEachNode(1, [&](int i) {
+    if (firstNodeOfSecondWorker < 0) {
+      firstNodeOfSecondWorker = i;
+    }
+    nodeFunction(i);
+  });
+  EXPECT_EQ(firstNodeOfSecondWorker, numNodes / 2);  // nothing measured yet: even split
+
+  for (int k = 0; k < 3; ++k) {
+    scheduler.reset(numNodes);
+    firstNodeOfSecondWorker = -1;
+    scheduler.forEachNode(1, [&](int i) {
+      if (firstNodeOfSecondWorker < 0) {
+        firstNodeOfSecondWorker = i;
+      }
+      nodeFunction(i);
+    });
+  }
+  EXPECT_EQ(firstNodeOfSecondWorker, 1);
+}
+
+TEST(testNodeScheduler, testStrategyNames) {
+  for (const auto strategy : {NodeSchedulingStrategy::DYNAMIC, NodeSchedulingStrategy::BLOCK, NodeSchedulingStrategy::COST_AWARE}) {
+    EXPECT_EQ(node_scheduling::fromString(node_scheduling::toString(strategy)), strategy);
+  }
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/WorkerTeam.h>
+#include <ocs2_oc/multiple_shooting/SpeculativeLinesearch.h>
+
+using namespace ocs2;
+using namespace multiple_shooting;
+
+namespace {
+/** The cost of a step decreases only for step sizes up to acceptableStepSize */
+scalar_t stepCost(scalar_t stepSize, scalar_t acceptableStepSize) {
+  return (stepSize <= acceptableStepSize) ? 0.5 : 2.0;
+}
+
+scalar_array_t getStepSizes(size_t numCandidates) {
+  scalar_array_t stepSizes{1.0};
+  while (stepSizes.size() < numCandidates) {
+    stepSizes.push_back(0.5 * stepSizes.back());
+  }
+  return stepSizes;
+}
+
+PerformanceIndex getBaseline() {
+  PerformanceIndex baseline;
+  baseline.cost = 1.0;
+  baseline.merit = 1.0;
+  return baseline;
+}
+}  // unnamed namespace
+
+TEST(testSpeculativeLinesearch, testSameAsSerial) {
+  constexpr size_t numWorkers = 3;
+  constexpr int numNodes = 11;
+  constexpr scalar_t armijoDescentMetric = -1.0;
+  WorkerTeam workerTeam(numWorkers);
+  const FilterLinesearch filterLinesearch;
+  const auto baseline = getBaseline();
+  const auto stepSizes = getStepSizes(5);
+
+  for (const auto strategy : {NodeSchedulingStrategy::DYNAMIC, NodeSchedulingStrategy::BLOCK, NodeSchedulingStrategy::COST_AWARE}) {
+    SpeculativeLinesearch linesearch(strategy, numWorkers);
+    for (const scalar_t acceptableStepSize : {1.0, 0.3, 0.1, 0.0}) {
+      // Serial backtracking
+      int expected = -1;
+      for (size_t c = 0; c < stepSizes.size(); ++c) {
+        PerformanceIndex performance;
+        performance.cost = stepCost(stepSizes[c], acceptableStepSize);
+        performance.merit = performance.cost;
+        if (filterLinesearch.acceptStep(baseline, performance, stepSizes[c] * armijoDescentMetric).first) {
+          expected = c;
+          break;
+        }
+      }
+
+      const int accepted = linesearch.run(workerTeam, filterLinesearch, baseline, armijoDescentMetric, stepSizes, numNodes,
+                                          [&](int /* workerId */, int c, int /* i */) {
+                                            PerformanceIndex performance;
+                                            performance.cost = stepCost(stepSizes[c], acceptableStepSize) / numNodes;
+                                            return performance;
+                                          });
+      EXPECT_EQ(accepted, expected) << "strategy: " << node_scheduling::toString(strategy) << ", acceptable: " << acceptableStepSize;
+
+      // All larger step sizes are evaluated and rejected
+      const auto& candidates = linesearch.getCandidates();
+      const int numRejected = (accepted < 0) ? stepSizes.size() : accepted;
+      for (int c = 0; c < numRejected; ++c) {
+        EXPECT_TRUE(candidates[c].evaluated);
+        EXPECT_FALSE(candidates[c].accepted);
+      }
+      if (accepted >= 0) {
+        EXPECT_TRUE(candidates[accepted].accepted);
+        EXPECT_NEAR(candidates[accepted].performance.cost, 0.5, 1e-9);
+        EXPECT_NEAR(candidates[accepted].performance.merit, 0.5, 1e-9);
+      }
+    }
+  }
+}
+
+TEST(testSpeculativeLinesearch, testCancellation) {
+  constexpr int numNodes = 4;
+  WorkerTeam workerTeam(1);
+  const FilterLinesearch filterLinesearch;
+  const auto stepSizes = getStepSizes(4);
+
+  // A single worker processes the candidates in order, hence nothing is evaluated after the accepted step size
+  SpeculativeLinesearch linesearch(NodeSchedulingStrategy::DYNAMIC, 1);
+  int numEvaluatedNodes = 0;
+  const int accepted = linesearch.run(workerTeam, filterLinesearch, getBaseline(), -1.0, stepSizes, numNodes, [&](int, int c, int) {
+    ++numEvaluatedNodes;
+    PerformanceIndex performance;
+    performance.cost = stepCost(stepSizes[c], 0.5) / numNodes;
+    return performance;
+  });
+
+  EXPECT_EQ(accepted, 1);
+  EXPECT_EQ(numEvaluatedNodes, 2 * numNodes);
+  EXPECT_FALSE(linesearch.getCandidates()[2].evaluated);
+  EXPECT_FALSE(linesearch.getCandidates()[3].evaluated);
+}
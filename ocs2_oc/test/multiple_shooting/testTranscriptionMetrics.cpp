@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 
@@ -65,6 +67,49 @@ TEST(test_transcription_metrics, intermediate) {
   ASSERT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
 }
 
+TEST(test_transcription_metrics, intermediateResidualsUpdate) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+
+  // optimal control problem: linear dynamics and constraints, such that only the cost Hessian depends on the point
+  OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+  problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+  // logarithmic barrier on a strictly feasible constraint, its gradient is not affine in the point
+  auto softConstraint = getRandomConstraints(nx, nu, 2);
+  softConstraint.f.array() += 10.0;
+  std::unique_ptr<PenaltyBase> penaltyPtr(new RelaxedBarrierPenalty(RelaxedBarrierPenalty::Config(0.1, 1e-3)));
+  problem.softConstraintPtr->add("softConstraint", std::unique_ptr<StateInputSoftConstraint>(new StateInputSoftConstraint(
+                                                       getOcs2Constraints(softConstraint), std::move(penaltyPtr))));
+  problem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 2)));
+  problem.stateEqualityConstraintPtr->add("stateEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 1)));
+  problem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+  problem.stateInequalityConstraintPtr->add("stateInequalityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 4)));
+
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const vector_t dx = vector_t::Random(nx);
+  const vector_t du = vector_t::Random(nu);
+  auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x - dx, x_next, u - du);
+  const matrix_t previousHessian = transcription.cost.dfduu;
+  multiple_shooting::updateIntermediateNodeResiduals(problem, discretizer, t, dt, x, x_next, u, transcription);
+  const auto expected = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+
+  ASSERT_TRUE(multiple_shooting::computeMetrics(expected).isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
+  ASSERT_TRUE(transcription.cost.dfdx.isApprox(expected.cost.dfdx, 1e-12));
+  ASSERT_TRUE(transcription.cost.dfdu.isApprox(expected.cost.dfdu, 1e-12));
+  ASSERT_TRUE(transcription.cost.dfduu.isApprox(previousHessian));
+}
+
 TEST(test_transcription_metrics, event) {
   constexpr int nx = 2;
 
@@ -65,6 +65,45 @@ TEST(test_transcription_performance, intermediate) {
   ASSERT_TRUE(performance.isApprox(multiple_shooting::computePerformanceIndex(transcription, dt), 1e-12));
 }
 
+TEST(test_transcription_performance, intermediateInPlace) {
+  constexpr int nx = 2;
+  constexpr int nu = 2;
+
+  // optimal control problems with and without inequality constraints
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  OptimalControlProblem constrainedProblem = problem;
+  constrainedProblem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+  constrainedProblem.stateInequalityConstraintPtr->add("stateInequalityConstraint",
+                                                       getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 4)));
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = (vector_t(nx) << 1.0, 0.1).finished();
+  const vector_t x_next = (vector_t(nx) << 1.1, 0.2).finished();
+  const vector_t u = (vector_t(nu) << 0.1, 1.3).finished();
+
+  // Reuse a projected transcription of the constrained problem for the other one
+  multiple_shooting::Transcription transcription;
+  multiple_shooting::setupIntermediateNode(constrainedProblem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  multiple_shooting::projectTranscription(transcription, true);
+  multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  const auto expected = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+
+  ASSERT_DOUBLE_EQ(transcription.cost.f, expected.cost.f);
+  ASSERT_TRUE(transcription.cost.dfdxx.isApprox(expected.cost.dfdxx));
+  ASSERT_TRUE(transcription.cost.dfduu.isApprox(expected.cost.dfduu));
+  ASSERT_TRUE(transcription.dynamics.dfdx.isApprox(expected.dynamics.dfdx));
+  ASSERT_TRUE(transcription.stateInputEqConstraints.dfdu.isApprox(expected.stateInputEqConstraints.dfdu));
+  ASSERT_EQ(transcription.stateIneqConstraints.f.size(), 0);
+  ASSERT_EQ(transcription.stateInputIneqConstraints.f.size(), 0);
+  ASSERT_EQ(transcription.constraintsProjection.f.size(), 0);
+  ASSERT_TRUE(transcription.constraintsSize.stateInputIneq.empty());
+  ASSERT_TRUE(multiple_shooting::computePerformanceIndex(transcription, dt).isApprox(
+      multiple_shooting::computePerformanceIndex(expected, dt), 1e-12));
+}
+
 TEST(test_transcription_performance, event) {
   constexpr int nx = 2;
 
@@ -29,7 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 
 #include "ocs2_oc/oc_problem/OcpToKkt.h"
 #include "ocs2_oc/precondition/Ruzi.h"
@@ -137,7 +137,7 @@ TEST_F(PreconditionTest, kktMatrixInPlace) {
 }
 
 TEST_F(PreconditionTest, ocpDataInPlaceInParallel) {
-  ocs2::ThreadPool threadPool(5, 99);
+  ocs2::WorkerTeam workerTeam(6, 99);
 
   ocs2::vector_t D_ref, E_ref;
   ocs2::scalar_t c_ref;
@@ -156,7 +156,7 @@ TEST_F(PreconditionTest, ocpDataInPlaceInParallel) {
   ocs2::vector_array_t D_array, E_array;
   ocs2::scalar_t c;
   ocs2::vector_array_t scalingVectors(N_);
-  ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize_, 5, dynamicsArray, costArray, D_array, E_array, scalingVectors, c);
+  ocs2::precondition::ocpDataInPlaceInParallel(workerTeam, x0, ocpSize_, 5, dynamicsArray, costArray, D_array, E_array, scalingVectors, c);
 
   ocs2::vector_t D_stacked(D_ref.rows()), E_stacked(E_ref.rows());
   int curRow = 0;
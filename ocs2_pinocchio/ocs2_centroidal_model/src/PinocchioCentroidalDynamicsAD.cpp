@@ -57,10 +57,12 @@ PinocchioCentroidalDynamicsAD::PinocchioCentroidalDynamicsAD(const PinocchioInte
       new CppAdInterface(systemFlowMapFunc, info.stateDim + info.inputDim, modelName + "_systemFlowMap", modelFolder));
 
   if (recompileLibraries) {
-    systemFlowMapCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    systemFlowMapCppAdInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    systemFlowMapCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    systemFlowMapCppAdInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
   }
+  // Within a CppAdDeferredWait the caller waits for the model
+  CppAdInterface::waitForModels({systemFlowMapCppAdInterfacePtr_.get()});
 }
 
 /******************************************************************************************************/
@@ -100,14 +100,17 @@ PinocchioEndEffectorKinematicsCppAd::PinocchioEndEffectorKinematicsCppAd(
       new CppAdInterface(orientationFunc, stateDim, 4 * endEffectorFrameIds_.size(), modelName + "_orientation", modelFolder));
 
   if (recompileLibraries) {
-    positionCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    positionCppAdInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    velocityCppAdInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    orientationErrorCppAdInterfacePtr_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    positionCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    positionCppAdInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    velocityCppAdInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    orientationErrorCppAdInterfacePtr_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
   }
+  // The models are compiled concurrently, within a CppAdDeferredWait the caller waits for them
+  CppAdInterface::waitForModels(
+      {positionCppAdInterfacePtr_.get(), velocityCppAdInterfacePtr_.get(), orientationErrorCppAdInterfacePtr_.get()});
 }
 
 /******************************************************************************************************/
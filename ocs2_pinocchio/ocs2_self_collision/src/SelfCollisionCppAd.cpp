@@ -49,12 +49,14 @@ SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterf
   PinocchioInterfaceCppAd pinocchioInterfaceAd = pinocchioInterface.toCppAd();
   setADInterfaces(pinocchioInterfaceAd, modelName, modelFolder);
   if (recompileLibraries) {
-    cppAdInterfaceDistanceCalculation_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    cppAdInterfaceDistanceCalculation_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    cppAdInterfaceLinkPoints_->createModelsAsync(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    cppAdInterfaceDistanceCalculation_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    cppAdInterfaceDistanceCalculation_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
+    cppAdInterfaceLinkPoints_->loadModelsIfAvailableAsync(CppAdInterface::ApproximationOrder::First, verbose);
   }
+  // The models are compiled concurrently, within a CppAdDeferredWait the caller waits for them
+  CppAdInterface::waitForModels({cppAdInterfaceDistanceCalculation_.get(), cppAdInterfaceLinkPoints_.get()});
 }
 
 /******************************************************************************************************/
@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
+#include <ocs2_ddp/riccati_equations/FixedSizeDiscreteTimeRiccatiEquations.h>
 
 // Boost
 #include <boost/filesystem/operations.hpp>
@@ -69,6 +70,9 @@ DoubleIntegratorInterface::DoubleIntegratorInterface(const std::string& taskFile
   ddpSettings_ = ddp::loadSettings(taskFile, "ddp", verbose);
   mpcSettings_ = mpc::loadSettings(taskFile, "mpc", verbose);
 
+  // Fixed-size Riccati kernel of the DDP solvers
+  discrete_time_riccati::registerFixedSizeMapILQR<STATE_DIM, INPUT_DIM>();
+
   /*
    * ReferenceManager & SolverSynchronizedModule
    */
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/AccessHelperFunctions.h>
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_centroidal_model/ModelHelperFunctions.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
@@ -133,6 +134,9 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   // Optimal control problem
   problemPtr_.reset(new OptimalControlProblem);
 
+  // The CppAD models of the dynamics and of the end-effector kinematics are compiled concurrently
+  CppAdDeferredWait cppAdDeferredWait;
+
   // Dynamics
   bool useAnalyticalGradientsDynamics = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
@@ -144,23 +148,13 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
     dynamicsPtr.reset(new LeggedRobotDynamicsAD(*pinocchioInterfacePtr_, centroidalModelInfo_, modelName, modelSettings_));
   }
 
-  problemPtr_->dynamicsPtr = std::move(dynamicsPtr);
-
-  // Cost terms
-  problemPtr_->costPtr->add("baseTrackingCost", getBaseTrackingCost(taskFile, centroidalModelInfo_, false));
-
-  // Constraint terms
-  // friction cone settings
-  scalar_t frictionCoefficient = 0.7;
-  RelaxedBarrierPenalty::Config barrierPenaltyConfig;
-  std::tie(frictionCoefficient, barrierPenaltyConfig) = loadFrictionConeSettings(taskFile, verbose);
-
+  // End-effector kinematics
   bool useAnalyticalGradientsConstraints = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsConstraints", useAnalyticalGradientsConstraints);
+  std::vector<std::unique_ptr<EndEffectorKinematics<scalar_t>>> eeKinematicsPtrs(centroidalModelInfo_.numThreeDofContacts);
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
     const std::string& footName = modelSettings_.contactNames3DoF[i];
 
-    std::unique_ptr<EndEffectorKinematics<scalar_t>> eeKinematicsPtr;
     if (useAnalyticalGradientsConstraints) {
       throw std::runtime_error(
           "[LeggedRobotInterface::setupOptimalConrolProblem] The analytical end-effector linear constraint is not implemented!");
@@ -171,11 +165,29 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
         const ad_vector_t q = centroidal_model::getGeneralizedCoordinates(state, infoCppAd);
         updateCentroidalDynamics(pinocchioInterfaceAd, infoCppAd, q);
       };
-      eeKinematicsPtr.reset(new PinocchioEndEffectorKinematicsCppAd(*pinocchioInterfacePtr_, pinocchioMappingCppAd, {footName},
-                                                                    centroidalModelInfo_.stateDim, centroidalModelInfo_.inputDim,
-                                                                    velocityUpdateCallback, footName, modelSettings_.modelFolderCppAd,
-                                                                    modelSettings_.recompileLibrariesCppAd, modelSettings_.verboseCppAd));
+      eeKinematicsPtrs[i].reset(new PinocchioEndEffectorKinematicsCppAd(
+          *pinocchioInterfacePtr_, pinocchioMappingCppAd, {footName}, centroidalModelInfo_.stateDim, centroidalModelInfo_.inputDim,
+          velocityUpdateCallback, footName, modelSettings_.modelFolderCppAd, modelSettings_.recompileLibrariesCppAd,
+          modelSettings_.verboseCppAd));
     }
+  }
+
+  // The constraints copy the end-effector kinematics, which requires their models
+  cppAdDeferredWait.waitAll();
+
+  problemPtr_->dynamicsPtr = std::move(dynamicsPtr);
+
+  // Cost terms
+  problemPtr_->costPtr->add("baseTrackingCost", getBaseTrackingCost(taskFile, centroidalModelInfo_, false));
+
+  // Constraint terms
+  // friction cone settings
+  scalar_t frictionCoefficient = 0.7;
+  RelaxedBarrierPenalty::Config barrierPenaltyConfig;
+  std::tie(frictionCoefficient, barrierPenaltyConfig) = loadFrictionConeSettings(taskFile, verbose);
+
+  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
+    const std::string& footName = modelSettings_.contactNames3DoF[i];
 
     if (useHardFrictionConeConstraint_) {
       problemPtr_->inequalityConstraintPtr->add(footName + "_frictionCone", getFrictionConeConstraint(i, frictionCoefficient));
@@ -185,9 +197,9 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
     }
     problemPtr_->equalityConstraintPtr->add(footName + "_zeroForce", getZeroForceConstraint(i));
     problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity",
-                                            getZeroVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
+                                            getZeroVelocityConstraint(*eeKinematicsPtrs[i], i, useAnalyticalGradientsConstraints));
     problemPtr_->equalityConstraintPtr->add(footName + "_normalVelocity",
-                                            getNormalVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
+                                            getNormalVelocityConstraint(*eeKinematicsPtrs[i], i, useAnalyticalGradientsConstraints));
   }
 
   // Pre-computation
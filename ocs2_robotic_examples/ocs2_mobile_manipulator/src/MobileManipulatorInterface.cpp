@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
 
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
@@ -162,21 +163,16 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
   // Cost
   problem_.costPtr->add("inputCost", getQuadraticInputCost(taskFile));
 
-  // Constraints
-  // joint limits constraint
-  problem_.softConstraintPtr->add("jointLimits", getJointLimitSoftConstraint(*pinocchioInterfacePtr_, taskFile));
-  // end-effector state constraint
-  problem_.stateSoftConstraintPtr->add("endEffector", getEndEffectorConstraint(*pinocchioInterfacePtr_, taskFile, "endEffector",
-                                                                               usePreComputation, libraryFolder, recompileLibraries));
-  problem_.finalSoftConstraintPtr->add("finalEndEffector", getEndEffectorConstraint(*pinocchioInterfacePtr_, taskFile, "finalEndEffector",
-                                                                                    usePreComputation, libraryFolder, recompileLibraries));
+  // The CppAD models of the self-collision constraint and of the dynamics are compiled concurrently with the end-effector kinematics
+  CppAdDeferredWait cppAdDeferredWait;
+
   // self-collision avoidance constraint
   bool activateSelfCollision = true;
   loadData::loadPtreeValue(pt, activateSelfCollision, "selfCollision.activate", true);
+  std::unique_ptr<StateCost> selfCollisionConstraintPtr;
   if (activateSelfCollision) {
-    problem_.stateSoftConstraintPtr->add(
-        "selfCollision", getSelfCollisionConstraint(*pinocchioInterfacePtr_, taskFile, urdfFile, "selfCollision", usePreComputation,
-                                                    libraryFolder, recompileLibraries));
+    selfCollisionConstraintPtr = getSelfCollisionConstraint(*pinocchioInterfacePtr_, taskFile, urdfFile, "selfCollision", usePreComputation,
+                                                            libraryFolder, recompileLibraries);
   }
 
   // Dynamics
@@ -205,6 +201,20 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
       throw std::invalid_argument("Invalid manipulator model type provided.");
   }
 
+  // Constraints
+  // joint limits constraint
+  problem_.softConstraintPtr->add("jointLimits", getJointLimitSoftConstraint(*pinocchioInterfacePtr_, taskFile));
+  // end-effector state constraint
+  problem_.stateSoftConstraintPtr->add("endEffector", getEndEffectorConstraint(*pinocchioInterfacePtr_, taskFile, "endEffector",
+                                                                               usePreComputation, libraryFolder, recompileLibraries));
+  problem_.finalSoftConstraintPtr->add("finalEndEffector", getEndEffectorConstraint(*pinocchioInterfacePtr_, taskFile, "finalEndEffector",
+                                                                                    usePreComputation, libraryFolder, recompileLibraries));
+  if (selfCollisionConstraintPtr != nullptr) {
+    problem_.stateSoftConstraintPtr->add("selfCollision", std::move(selfCollisionConstraintPtr));
+  }
+
+  cppAdDeferredWait.waitAll();
+
   /*
    * Pre-computation
    */
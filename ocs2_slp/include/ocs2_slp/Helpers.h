@@ -30,7 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 
 namespace ocs2 {
@@ -90,7 +90,7 @@ scalar_t hessianEigenvaluesUpperBound(const OcpSize& ocpSize, const std::vector<
  *
  * g = [(A0 x0 + b0); b1; ...; bn, -(C0 x0 + e0); -e1; ...; en]
  *
- * @param [in] threadPool: The thread pool.
+ * @param [in] workerTeam: The worker team.
  * @param [in] ocpSize: The size of optimal control problem.
  * @param [in] dynamics: Linear approximation of the dynamics over the time horizon.
  * @param [in] constraints: Linear approximation of the constraints over the time horizon. Pass nullptr if there is no constraints.
@@ -98,7 +98,7 @@ scalar_t hessianEigenvaluesUpperBound(const OcpSize& ocpSize, const std::vector<
  *                                they become arbitrary diagonal matrices. Pass nullptr to get them filled with identity matrices.
  * @return: The upper bound of eigenvalues for G G'.
  */
-scalar_t GGTEigenvaluesUpperBound(ThreadPool& threadPool, const OcpSize& ocpSize,
+scalar_t GGTEigenvaluesUpperBound(WorkerTeam& workerTeam, const OcpSize& ocpSize,
                                   const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                   const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
                                   const vector_array_t* scalingVectorsPtr);
@@ -141,7 +141,7 @@ vector_t hessianAbsRowSum(const OcpSize& ocpSize, const std::vector<ScalarFuncti
  *
  * g = [(A0 x0 + b0); b1; ...; bn, -(C0 x0 + e0); -e1; ...; en]
  *
- * @param [in] threadPool: The thread pool.
+ * @param [in] workerTeam: The worker team.
  * @param [in] ocpSize: The size of optimal control problem.
  * @param [in] dynamics: Linear approximation of the dynamics over the time horizon.
  * @param [in] constraints: Linear approximation of the constraints over the time horizon. Pass nullptr if there is no constraints.
@@ -149,7 +149,7 @@ vector_t hessianAbsRowSum(const OcpSize& ocpSize, const std::vector<ScalarFuncti
  *                                they become arbitrary diagonal matrices. Pass nullptr to get them filled with identity matrices.
  * @return The absolute sum of rows of matrix G G'.
  */
-vector_t GGTAbsRowSumInParallel(ThreadPool& threadPool, const OcpSize& ocpSize,
+vector_t GGTAbsRowSumInParallel(WorkerTeam& workerTeam, const OcpSize& ocpSize,
                                 const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
                                 const vector_array_t* scalingVectorsPtr);
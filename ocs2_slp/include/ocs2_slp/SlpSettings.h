@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
+#include <ocs2_oc/multiple_shooting/NodeScheduler.h>
+
 #include "ocs2_slp/pipg/PipgSettings.h"
 
 namespace ocs2 {
@@ -45,8 +47,9 @@ struct Settings {
   scalar_t costTol = 1e-4;      // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;      // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;       // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchBatchSize = 1;  // number of step sizes {alpha, alpha * alpha_decay, ...} evaluated in parallel. 1: serial linesearch
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -73,6 +76,10 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::vector<int> threadAffinity;  // CPU cores of the worker threads, see ThreadPool
+  // Distribution of the nodes among the threads (DYNAMIC, BLOCK, COST_AWARE) and number of consecutive nodes claimed at once
+  multiple_shooting::NodeSchedulingStrategy nodeScheduling = multiple_shooting::NodeSchedulingStrategy::DYNAMIC;
+  size_t nodeSchedulingGrainSize = 1;
 
   // LP subproblem solver settings
   pipg::Settings pipgSettings = pipg::Settings();
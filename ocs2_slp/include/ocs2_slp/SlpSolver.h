@@ -32,9 +32,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 
+#include <ocs2_oc/multiple_shooting/NodeScheduler.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/SpeculativeLinesearch.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -113,7 +116,10 @@ class SlpSolver : public SolverBase {
   }
 
   /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction) {
+    workerTeam_.run(std::forward<Functor>(taskFunction));
+  }
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -128,6 +134,10 @@ class SlpSolver : public SolverBase {
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                       const vector_array_t& u, std::vector<Metrics>& metrics);
 
+  /** Computes the performance metrics of node i, without the initial state constraint */
+  PerformanceIndex computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, int i,
+                                          const vector_array_t& x, const vector_array_t& u, Metrics& metrics);
+
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;      // delta_x(t)
@@ -144,6 +154,11 @@ class SlpSolver : public SolverBase {
                          const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u,
                          std::vector<Metrics>& metrics);
 
+  /** Same as takeStep, but evaluates settings.linesearchBatchSize step sizes concurrently */
+  slp::StepInfo takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                    const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                    vector_array_t& u, std::vector<Metrics>& metrics);
+
   /** Determine convergence after a step */
   slp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const slp::StepInfo& stepInfo) const;
 
@@ -159,7 +174,13 @@ class SlpSolver : public SolverBase {
   PipgSolver pipgSolver_;
 
   // Threading
-  ThreadPool threadPool_;
+  WorkerTeam workerTeam_;
+  multiple_shooting::NodeScheduler linearizationScheduler_;
+  multiple_shooting::NodeScheduler performanceScheduler_;
+  multiple_shooting::SpeculativeLinesearch speculativeLinesearch_;
+  std::vector<vector_array_t> candidateStates_;  // state trajectories of the speculative linesearch candidates
+  std::vector<vector_array_t> candidateInputs_;  // input trajectories of the speculative linesearch candidates
+  std::vector<std::vector<Metrics>> candidateMetrics_;  // metrics of the speculative linesearch candidates
 
   // Solution
   PrimalSolution primalSolution_;
@@ -172,6 +193,9 @@ class SlpSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Transcription of the intermediate nodes. It is kept across iterations and MPC calls, such that the memory of a node is reused.
+  std::vector<multiple_shooting::Transcription> transcriptions_;
+
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
@@ -35,7 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Benchmark.h>
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/misc/ContiguousTrajectory.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 
 #include "ocs2_slp/pipg/PipgBounds.h"
@@ -60,7 +61,7 @@ class PipgSolver {
   /**
    * Solve the optimal control in parallel.
    *
-   * @param [in] threadPool : The external thread pool.
+   * @param [in] workerTeam : The external worker team.
    * @param [in] x0 : Initial state
    * @param [in] dynamics : Dynamics array.
    * @param [in] cost : Cost array.
@@ -73,7 +74,7 @@ class PipgSolver {
    * @param [out] uTrajectory : The optimized input trajectory.
    * @return The solver status.
    */
-  pipg::SolverStatus solve(ThreadPool& threadPool, const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+  pipg::SolverStatus solve(WorkerTeam& workerTeam, const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                            const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                            const std::vector<VectorFunctionLinearApproximation>* constraints, const vector_array_t& scalingVectors,
                            const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, vector_array_t& xTrajectory,
@@ -102,9 +103,9 @@ class PipgSolver {
   int numDecisionVariables_;
   int numDynamicsConstraints_;
 
-  // Data buffer for parallelized PIPG
-  vector_array_t X_, W_, V_, U_;
-  vector_array_t XNew_, UNew_, WNew_;
+  // Data buffer for parallelized PIPG. Each trajectory is stored in a single contiguous buffer.
+  ContiguousTrajectory X_, W_, V_, U_;
+  ContiguousTrajectory XNew_, UNew_, WNew_;
 };
 
 }  // namespace ocs2
@@ -55,11 +55,11 @@ scalar_t hessianEigenvaluesUpperBound(const OcpSize& ocpSize, const std::vector<
   return rowwiseAbsSumH.maxCoeff();
 }
 
-scalar_t GGTEigenvaluesUpperBound(ThreadPool& threadPool, const OcpSize& ocpSize,
+scalar_t GGTEigenvaluesUpperBound(WorkerTeam& workerTeam, const OcpSize& ocpSize,
                                   const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                   const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
                                   const vector_array_t* scalingVectorsPtr) {
-  const vector_t rowwiseAbsSumGGT = GGTAbsRowSumInParallel(threadPool, ocpSize, dynamics, constraintsPtr, scalingVectorsPtr);
+  const vector_t rowwiseAbsSumGGT = GGTAbsRowSumInParallel(workerTeam, ocpSize, dynamics, constraintsPtr, scalingVectorsPtr);
   return rowwiseAbsSumGGT.maxCoeff();
 }
 
@@ -92,7 +92,7 @@ vector_t hessianAbsRowSum(const OcpSize& ocpSize, const std::vector<ScalarFuncti
   return res;
 }
 
-vector_t GGTAbsRowSumInParallel(ThreadPool& threadPool, const OcpSize& ocpSize,
+vector_t GGTAbsRowSumInParallel(WorkerTeam& workerTeam, const OcpSize& ocpSize,
                                 const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints,
                                 const vector_array_t* scalingVectorsPtr) {
@@ -145,7 +145,7 @@ vector_t GGTAbsRowSumInParallel(ThreadPool& threadPool, const OcpSize& ocpSize,
       }
     }
   };
-  threadPool.runParallel(std::move(task), threadPool.numThreads() + 1U);
+  workerTeam.run(task);
 
   vector_t res = vector_t::Zero(getNumDynamicsConstraints(ocpSize));
   int curRow = 0;
@@ -48,7 +48,13 @@ namespace ocs2 {
 SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(std::move(settings)),
       pipgSolver_(settings_.pipgSettings),
-      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority) {
+      workerTeam_(std::max(settings_.nThreads - 1, size_t(1)), settings_.threadPriority, settings_.threadAffinity),
+      linearizationScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      performanceScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      speculativeLinesearch_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      candidateStates_(settings_.linesearchBatchSize),
+      candidateInputs_(settings_.linesearchBatchSize),
+      candidateMetrics_(settings_.linesearchBatchSize) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -57,9 +63,7 @@ SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optima
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
   // Clone objects to have one for each worker
-  for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
-  }
+  workerTeam_.makeLocalCopies(optimalControlProblem, ocpDefinitions_, settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -232,10 +236,6 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SlpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
-}
-
 SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta_x0) {
   // Solve the QP
   OcpSubproblemSolution solution;
@@ -250,7 +250,7 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   scalar_t c;
   vector_array_t D, E;
   vector_array_t scalingVectors;
-  precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, pipgSolver_.size(), settings_.scalingIteration, dynamics_, cost_, D, E,
+  precondition::ocpDataInPlaceInParallel(workerTeam_, delta_x0, pipgSolver_.size(), settings_.scalingIteration, dynamics_, cost_, D, E,
                                          scalingVectors, c);
   preConditioning_.endTimer();
 
@@ -271,7 +271,7 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   // estimate sigma: G' G < sigma I
   // However, since the G'G and GG' have exactly the same set of eigenvalues value: G G' < sigma I
   sigmaEstimation_.startTimer();
-  const auto sigmaScaled = slp::GGTEigenvaluesUpperBound(threadPool_, pipgSolver_.size(), dynamics_, nullptr, &scalingVectors);
+  const auto sigmaScaled = slp::GGTEigenvaluesUpperBound(workerTeam_, pipgSolver_.size(), dynamics_, nullptr, &scalingVectors);
   sigmaEstimation_.endTimer();
 
   pipgSolverTimer_.startTimer();
@@ -279,7 +279,7 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   std::transform(E.begin(), E.end(), EInv.begin(), [](const vector_t& v) { return v.cwiseInverse(); });
   const pipg::PipgBounds pipgBounds{muEstimated, lambdaScaled, sigmaScaled};
   const auto pipgStatus =
-      pipgSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, nullptr, scalingVectors, &EInv, pipgBounds, deltaXSol, deltaUSol);
+      pipgSolver_.solve(workerTeam_, delta_x0, dynamics_, cost_, nullptr, scalingVectors, &EInv, pipgBounds, deltaXSol, deltaUSol);
   pipgSolverTimer_.endTimer();
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -311,17 +311,25 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  transcriptions_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
+  linearizationScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    linearizationScheduler_.forEachNode(workerId, [&](int i) {
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+        metrics[i] = multiple_shooting::computeMetrics(result);
+        workerPerformance += multiple_shooting::computePerformanceIndex(result);
+        cost_[i] = std::move(result.cost);
+        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
         metrics[i] = multiple_shooting::computeMetrics(result);
@@ -337,30 +345,21 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        auto& result = transcriptions_[i];
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
         metrics[i] = multiple_shooting::computeMetrics(result);
         workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
         multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+        // Swap instead of move, such that the transcription keeps the memory of the previous iteration
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+        std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-    }
+    });
 
     // Accumulate! Same worker might run multiple tasks
     performance[workerId] += workerPerformance;
@@ -384,33 +383,13 @@ PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>&
   metrics.resize(N + 1);
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  performanceScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
-    }
+    performanceScheduler_.forEachNode(
+        workerId, [&](int i) { performance[workerId] += computeNodePerformance(ocpDefinition, time, i, x, u, metrics[i]); });
   };
   runParallel(std::move(parallelTask));
 
@@ -425,11 +404,36 @@ PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>&
   return totalPerformance;
 }
 
+PerformanceIndex SlpSolver::computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, int i,
+                                                   const vector_array_t& x, const vector_array_t& u, Metrics& metrics) {
+  const int N = static_cast<int>(time.size()) - 1;
+  if (i == N) {
+    // Terminal node
+    const scalar_t tN = getIntervalStart(time[N]);
+    metrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+    return toPerformanceIndex(metrics);
+  } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    metrics = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+    return toPerformanceIndex(metrics);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    metrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+    return toPerformanceIndex(metrics, dt);
+  }
+}
+
 slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.linesearchBatchSize > 1) {
+    return takeSpeculativeStep(baseline, timeDiscretization, initState, subproblemSolution, x, u, metrics);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -520,6 +524,82 @@ slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   return stepInfo;
 }
 
+slp::StepInfo SlpSolver::takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                             const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                             vector_array_t& u, std::vector<Metrics>& metrics) {
+  using StepType = FilterLinesearch::StepType;
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  const auto stepSizes = multiple_shooting::SpeculativeLinesearch::getStepSizes(1.0, settings_.alpha_decay, settings_.alpha_min,
+                                                                                settings_.deltaTol, deltaXnorm, deltaUnorm);
+  const int numNodes = static_cast<int>(timeDiscretization.size());
+  const size_t batchSize = std::min(settings_.linesearchBatchSize, stepSizes.size());
+  // The candidate buffers keep their memory across iterations, resizing is a no-op once the horizon is stable
+  auto& xNew = candidateStates_;
+  auto& uNew = candidateInputs_;
+  auto& metricsNew = candidateMetrics_;
+  for (size_t c = 0; c < batchSize; c++) {
+    xNew[c].resize(x.size());
+    uNew[c].resize(u.size());
+    metricsNew[c].resize(numNodes);
+  }
+
+  const int accepted = speculativeLinesearch_.backtrack(
+      workerTeam_, filterLinesearch_, baseline, subproblemSolution.armijoDescentMetric, stepSizes, batchSize, numNodes,
+      [&](int c, scalar_t alpha) {
+        multiple_shooting::incrementTrajectory(u, du, alpha, uNew[c]);
+        multiple_shooting::incrementTrajectory(x, dx, alpha, xNew[c]);
+      },
+      [&](int workerId, int c, int i) {
+        auto performance = computeNodePerformance(ocpDefinitions_[workerId], timeDiscretization, i, xNew[c], uNew[c], metricsNew[c][i]);
+        if (i == 0) {
+          // Account for initial state in performance
+          const vector_t initDynamicsViolation = initState - xNew[c].front();
+          metricsNew[c].front().dynamicsViolation += initDynamicsViolation;
+          performance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+        }
+        return performance;
+      },
+      settings_.printLinesearch, deltaXnorm, deltaUnorm);
+
+  if (accepted >= 0) {  // Return if step accepted
+    const auto& candidate = speculativeLinesearch_.getCandidates()[accepted];
+    x.swap(xNew[accepted]);
+    u.swap(uNew[accepted]);
+    metrics.swap(metricsNew[accepted]);
+
+    // Prepare step info
+    slp::StepInfo stepInfo;
+    stepInfo.stepSize = candidate.stepSize;
+    stepInfo.stepType = candidate.stepType;
+    stepInfo.dx_norm = candidate.stepSize * deltaXnorm;
+    stepInfo.du_norm = candidate.stepSize * deltaUnorm;
+    stepInfo.performanceAfterStep = candidate.performance;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(candidate.performance);
+    return stepInfo;
+  }
+
+  // Alpha_min reached -> Don't take a step
+  slp::StepInfo stepInfo;
+  stepInfo.stepSize = 0.0;
+  stepInfo.stepType = StepType::ZERO;
+  stepInfo.dx_norm = 0.0;
+  stepInfo.du_norm = 0.0;
+  stepInfo.performanceAfterStep = baseline;
+  stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+
+  if (settings_.printLinesearch) {
+    std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+  }
+
+  return stepInfo;
+}
+
 slp::Convergence SlpSolver::checkConvergence(int iteration, const PerformanceIndex& baseline, const slp::StepInfo& stepInfo) const {
   using Convergence = slp::Convergence;
   if ((iteration + 1) >= settings_.slpIteration) {
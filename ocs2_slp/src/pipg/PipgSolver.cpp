@@ -29,9 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/pipg/PipgSolver.h"
 
-#include <condition_variable>
+#include <functional>
 #include <iostream>
-#include <mutex>
 #include <numeric>
 
 namespace ocs2 {
@@ -46,7 +45,7 @@ PipgSolver::PipgSolver(pipg::Settings settings) : settings_(std::move(settings))
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+pipg::SolverStatus PipgSolver::solve(WorkerTeam& workerTeam, const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                                      const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                      const std::vector<VectorFunctionLinearApproximation>* constraints,
                                      const vector_array_t& scalingVectors, const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds,
@@ -64,51 +63,41 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   Eigen::setNbThreads(1);
 
   vector_array_t primalResidualArray(N);
-  scalar_array_t constraintsViolationInfNormArray(N);
   scalar_t constraintsViolationInfNorm;
-
   scalar_t solutionSSE, solutionSquaredNorm;
-  scalar_array_t solutionSEArray(N);
-  scalar_array_t solutionSquaredNormArray(N);
 
+  // cold start
+  X_.setZero();
+  U_.setZero();
+  W_.setZero();
+  // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
+  WNew_.setZero();
   // initial state
   X_[0] = x0;
   XNew_[0] = x0;
-  // cold start
-  for (int t = 0; t < N; t++) {
-    X_[t + 1].setZero(dynamics[t].dfdx.rows());
-    U_[t].setZero(dynamics[t].dfdu.cols());
-    W_[t].setZero(dynamics[t].dfdx.rows());
-    // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
-    WNew_[t].setZero(dynamics[t].dfdx.rows());
-  }
 
   scalar_t alpha = pipgBounds.primalStepSize(0);
   scalar_t beta = pipgBounds.primalStepSize(0);
   scalar_t betaLast = 0;
 
   size_t k = 0;
-  std::atomic_int timeIndex{1}, finishedTaskCounter{0};
-  std::atomic_bool keepRunning{true}, shouldWait{true};
+  std::atomic_int timeIndex{1};
+  bool keepRunning = true;
   bool isConverged = false;
 
-  std::mutex mux;
-  std::condition_variable iterationFinished;
-  std::vector<int> threadsWorkloadCounter(threadPool.numThreads() + 1U, 0);
+  std::vector<int> threadsWorkloadCounter(workerTeam.size(), 0);
 
   auto updateVariablesTask = [&](int workerId) {
     int t;
-    int workerOrder;
 
+    // The shared variables (k, alpha, beta, keepRunning, ...) are only modified in the serial section of the barrier.
     while (keepRunning) {
-      // Reset workerOrder in case all tasks have been assigned and some workers cannot enter the following while loop, keeping the
-      // workerOrder from previous iterations.
-      workerOrder = 0;
+      const bool checkTermination = k != 0 && k % settings().checkTerminationInterval == 0;
+      scalar_t workerConstraintsViolationInfNorm = 0.0;
+      scalar_t workerSolutionSSE = 0.0;
+      scalar_t workerSolutionSquaredNorm = 0.0;
+
       while ((t = timeIndex++) <= N) {
-        if (t == N) {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = true;
-        }
         // Multi-thread performance analysis
         ++threadsWorkloadCounter[workerId];
 
@@ -131,11 +120,6 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
           primalResidualArray[t - 1].array() += C.array() * X_[t].array();
           primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
           primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
-          }
 
           WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
 
@@ -145,8 +129,14 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
           UNew_[t - 1] -= U_[t - 1];
           XNew_[t] -= X_[t];
 
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+          if (checkTermination) {
+            const scalar_t constraintsViolation = (EInv != nullptr)
+                                                      ? (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>()
+                                                      : primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
+            workerConstraintsViolationInfNorm = std::max(workerConstraintsViolationInfNorm, constraintsViolation);
+            workerSolutionSSE += UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
+            workerSolutionSquaredNorm += U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+          }
         }
 
         // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
@@ -185,26 +175,26 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
           // Add dfdxu * du if it is not the final state.
           XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
         }
+      }
 
-        workerOrder = ++finishedTaskCounter;
+      if (checkTermination) {
+        const auto max = [](scalar_t a, scalar_t b) { return std::max(a, b); };
+        workerConstraintsViolationInfNorm = workerTeam.allReduce(workerId, workerConstraintsViolationInfNorm, max);
+        workerSolutionSSE = workerTeam.allReduce(workerId, workerSolutionSSE, std::plus<scalar_t>());
+        workerSolutionSquaredNorm = workerTeam.allReduce(workerId, workerSolutionSquaredNorm, std::plus<scalar_t>());
       }
 
-      if (workerOrder != N) {
-        std::unique_lock<std::mutex> lk(mux);
-        iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
-        lk.unlock();
-      } else {
+      // Wait for all the stages of this iteration. The last worker to arrive prepares the next iteration.
+      workerTeam.barrier([&] {
         betaLast = beta;
         // Adaptive step size
         beta = pipgBounds.dualStepSize(k);
         alpha = pipgBounds.primalStepSize(k);
 
-        if (k != 0 && k % settings().checkTerminationInterval == 0) {
-          constraintsViolationInfNorm =
-              *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
-
-          solutionSSE = std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0);
-          solutionSquaredNorm = std::accumulate(solutionSquaredNormArray.begin(), solutionSquaredNormArray.end(), 0.0);
+        if (checkTermination) {
+          constraintsViolationInfNorm = workerConstraintsViolationInfNorm;
+          solutionSSE = workerSolutionSSE;
+          solutionSquaredNorm = workerSolutionSquaredNorm;
 
           isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
                         (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
@@ -218,20 +208,14 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
         WNew_.swap(W_);
 
         ++k;
-        finishedTaskCounter = 0;
         timeIndex = 1;
-        {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = false;
-        }
-        iterationFinished.notify_all();
-      }
+      });
     }
   };
-  threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
+  workerTeam.run(updateVariablesTask);
 
-  xTrajectory = X_;
-  uTrajectory = U_;
+  X_.toVectorArray(xTrajectory);
+  U_.toVectorArray(uTrajectory);
   const auto status = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
 
   if (settings().displayShortSummary) {
@@ -271,13 +255,15 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
   numDecisionVariables_ += std::accumulate(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end(), 0);
   numDynamicsConstraints_ = std::accumulate(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), 0);
 
-  X_.resize(N + 1);
-  W_.resize(N);
-  V_.resize(N);
-  U_.resize(N);
-  XNew_.resize(N + 1);
-  UNew_.resize(N);
-  WNew_.resize(N);
+  const std::vector<int> inputSizes(ocpSize_.numInputs.begin(), std::next(ocpSize_.numInputs.begin(), N));
+  const std::vector<int> dualSizes(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end());
+  X_.resize(ocpSize_.numStates);
+  W_.resize(dualSizes);
+  V_.resize(dualSizes);
+  U_.resize(inputSizes);
+  XNew_.resize(ocpSize_.numStates);
+  UNew_.resize(inputSizes);
+  WNew_.resize(dualSizes);
 }
 
 /******************************************************************************************************/
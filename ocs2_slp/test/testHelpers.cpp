@@ -45,7 +45,7 @@ class HelperFunctionTest : public testing::Test {
   static constexpr size_t numConstraints = N_ * (nx_ + nc_);
   static constexpr bool verbose = true;
 
-  HelperFunctionTest() : threadPool_(5, 99) {
+  HelperFunctionTest() : workerTeam_(6, 99) {
     srand(10);
 
     // Construct OCP problem
@@ -71,7 +71,7 @@ class HelperFunctionTest : public testing::Test {
   std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
   std::vector<ocs2::VectorFunctionLinearApproximation> constraintsArray;
 
-  ocs2::ThreadPool threadPool_;
+  ocs2::WorkerTeam workerTeam_;
 };
 
 TEST_F(HelperFunctionTest, hessianAbsRowSum) {
@@ -87,7 +87,7 @@ TEST_F(HelperFunctionTest, GGTAbsRowSumInParallel) {
   }
 
   ocs2::getConstraintMatrix(ocpSize_, x0, dynamicsArray, nullptr, &scalingVectors, constraintsApproximation);
-  ocs2::vector_t rowwiseSum = ocs2::slp::GGTAbsRowSumInParallel(threadPool_, ocpSize_, dynamicsArray, nullptr, &scalingVectors);
+  ocs2::vector_t rowwiseSum = ocs2::slp::GGTAbsRowSumInParallel(workerTeam_, ocpSize_, dynamicsArray, nullptr, &scalingVectors);
   ocs2::matrix_t GGT = constraintsApproximation.dfdx * constraintsApproximation.dfdx.transpose();
   EXPECT_TRUE(rowwiseSum.isApprox(GGT.cwiseAbs().rowwise().sum()));
 }
\ No newline at end of file
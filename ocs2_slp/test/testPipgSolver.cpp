@@ -88,7 +88,7 @@ class PIPGSolverTest : public testing::Test {
   std::vector<ocs2::VectorFunctionLinearApproximation> constraintsArray;
 
   ocs2::PipgSolver solver;
-  ocs2::ThreadPool threadPool{numThreads_ - 1u, 50};
+  ocs2::WorkerTeam workerTeam{numThreads_, 50};
 };
 
 constexpr size_t PIPGSolverTest::N_;
@@ -122,7 +122,7 @@ TEST_F(PIPGSolverTest, correctness) {
 
   ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
   ocs2::vector_array_t X, U;
-  std::ignore = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  std::ignore = solver.solve(workerTeam, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
 
   ocs2::vector_t primalSolutionPIPGParallel;
   ocs2::toKktSolution(X, U, primalSolutionPIPGParallel);
@@ -40,7 +40,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunctionLinearApproximation& dynamicsMatrices,
                                                                const ScalarFunctionQuadraticApproximation& costMatrices,
-                                                               const ocs2::scalar_t tol) {
+                                                               const ocs2::scalar_t tol, size_t linesearchBatchSize = 1) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -84,6 +84,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
     settings.printSolverStatus = true;
     settings.printLinesearch = true;
     settings.nThreads = 100;
+    settings.linesearchBatchSize = linesearchBatchSize;
     settings.pipgSettings = getPipgSettings();
     return settings;
   }();
@@ -121,3 +122,18 @@ TEST(testSlpSolver, test_unconstrained) {
   ASSERT_LE(result.second.size(), 2);
   ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
 }
+
+TEST(testSlpSolver, test_speculativeLinesearch) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto serialResult = ocs2::solve(dynamics, costs, tol);
+  const auto speculativeResult = ocs2::solve(dynamics, costs, tol, 4);
+
+  // Same steps as the serial linesearch
+  ASSERT_EQ(speculativeResult.second.size(), serialResult.second.size());
+  ASSERT_NEAR(speculativeResult.second.back().merit, serialResult.second.back().merit, 1e-6);
+  ASSERT_LT(speculativeResult.second.back().dynamicsViolationSSE, tol);
+}
@@ -50,6 +50,12 @@ class HpipmInterface {
  public:
   using Settings = hpipm_interface::Settings;
 
+  /** Primal solution of a QP in the variables of HPIPM, see getSolution() and setInitialGuess(). */
+  struct Solution {
+    vector_array_t stateTrajectory;  // x[k], the initial state is not a decision variable
+    vector_array_t inputTrajectory;  // u[k]
+  };
+
   /**
    * Construct the Hpipm interface with given size and settings.
    * Can directly call solve() for a problem with consistent size.
@@ -59,8 +65,8 @@ class HpipmInterface {
   /** Destructor */
   ~HpipmInterface();
 
-  /** Resize the problem */
-  void resize(OcpSize ocpSize);
+  /** Resize the problem. Does nothing if the size did not change. */
+  void resize(const OcpSize& ocpSize);
 
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
@@ -86,6 +92,27 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Gets the primal solution of the previous solve().
+   *
+   * @param [out] solution : The solution in the variables of HPIPM, i.e., without the initial state.
+   */
+  void getSolution(Solution& solution) const;
+
+  /**
+   * Sets the primal initial guess of the next solve(), for instance the (time-shifted) solution of a previous, similar problem. It is
+   * meant for settings.warm_start = 1. HPIPM then initializes the slacks and multipliers from this guess. With settings.warm_start = 2,
+   * HPIPM would combine this guess with the slacks and multipliers of its previous solve(), which are not shifted and cannot be set
+   * through the HPIPM API. The guess has to be set after the last resize(), since resizing to a different problem size discards it.
+   *
+   * @param guess : The initial guess. The initial state is not a decision variable and is ignored. Nodes missing from the trajectories,
+   * or with a guess of inconsistent size, start from zero.
+   */
+  void setInitialGuess(const Solution& guess);
+
+  /** Returns the number of interior point iterations of the previous solve() */
+  int getNumIterations() const;
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
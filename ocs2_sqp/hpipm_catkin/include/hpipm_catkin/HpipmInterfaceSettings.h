@@ -51,6 +51,7 @@ struct Settings {
   scalar_t tol_ineq = 1e-8;  // res_d_max
   scalar_t tol_comp = 1e-8;  // res_m_max
   scalar_t reg_prim = 1e-12;
+  // 0: cold start, 1: primal warm start, see HpipmInterface::setInitialGuess, 2: primal-dual warm start from the previous solve()
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -87,19 +89,19 @@ namespace ocs2 {
 
 class HpipmInterface::Impl {
  public:
-  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
-
-  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false) {
-    // We will remove the initial state from the decision variables before passing the data to HPIPM.
-    // This removes the need for adding constraints to enforce x[0] = x_init
-    ocpSize.numStates[0] = 0;
+  Impl(const OcpSize& ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(ocpSize, true); }
 
+  void initializeMemory(const OcpSize& ocpSize, bool forceInitialization = false) {
     // Skip memory initialization if problem size didn't change.
-    if (!forceInitialization && ocpSize_ == ocpSize) {
+    if (!forceInitialization && requestedOcpSize_ == ocpSize) {
       return;
     }
 
-    ocpSize_ = std::move(ocpSize);
+    // We will remove the initial state from the decision variables before passing the data to HPIPM.
+    // This removes the need for adding constraints to enforce x[0] = x_init
+    requestedOcpSize_ = ocpSize;
+    ocpSize_ = ocpSize;
+    ocpSize_.numStates[0] = 0;
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
@@ -170,9 +172,9 @@ class HpipmInterface::Impl {
     verifySizes(x0, dynamics, cost, constraints);
 
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
+    AA_.assign(N, nullptr);
+    BB_.assign(N, nullptr);
+    bb_.assign(N, nullptr);
 
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
@@ -181,85 +183,84 @@ class HpipmInterface::Impl {
     //         = B[0]*u[0] + (b[0] + A[0]*x[0])
     //         = B[0]*u[0] + \tilde{b}[0]
     // numState[0] = 0 --> No need to specify A[0] here
-    vector_t b0 = dynamics[0].f;
-    b0.noalias() += dynamics[0].dfdx * x0;
-    BB[0] = dynamics[0].dfdu.data();
-    bb[0] = b0.data();
+    b0_ = dynamics[0].f;
+    b0_.noalias() += dynamics[0].dfdx * x0;
+    BB_[0] = dynamics[0].dfdu.data();
+    bb_[0] = b0_.data();
 
     // k = 1 -> N-1
     for (int k = 1; k < N; k++) {
-      AA[k] = dynamics[k].dfdx.data();
-      BB[k] = dynamics[k].dfdu.data();
-      bb[k] = dynamics[k].f.data();
+      AA_[k] = dynamics[k].dfdx.data();
+      BB_[k] = dynamics[k].dfdu.data();
+      bb_[k] = dynamics[k].f.data();
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
+    QQ_.assign(N + 1, nullptr);
+    RR_.assign(N + 1, nullptr);
+    SS_.assign(N + 1, nullptr);
+    qq_.assign(N + 1, nullptr);
+    rr_.assign(N + 1, nullptr);
 
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
-    vector_t r0 = cost[0].dfdu;
-    r0 += cost[0].dfdux * x0;
-    RR[0] = cost[0].dfduu.data();
-    rr[0] = r0.data();
+    r0_ = cost[0].dfdu;
+    r0_.noalias() += cost[0].dfdux * x0;
+    RR_[0] = cost[0].dfduu.data();
+    rr_[0] = r0_.data();
 
     // k = 1 -> (N-1)
     for (int k = 1; k < N; k++) {
-      QQ[k] = cost[k].dfdxx.data();
-      RR[k] = cost[k].dfduu.data();
-      SS[k] = cost[k].dfdux.data();
-      qq[k] = cost[k].dfdx.data();
-      rr[k] = cost[k].dfdu.data();
+      QQ_[k] = cost[k].dfdxx.data();
+      RR_[k] = cost[k].dfduu.data();
+      SS_[k] = cost[k].dfdux.data();
+      qq_[k] = cost[k].dfdx.data();
+      rr_[k] = cost[k].dfdu.data();
     }
 
     // k = N, no inputs
-    QQ[N] = cost[N].dfdxx.data();
-    qq[N] = cost[N].dfdx.data();
+    QQ_[N] = cost[N].dfdxx.data();
+    qq_[N] = cost[N].dfdx.data();
 
     // === Constraints ===
     // for ocs2 --> C*dx + D*du + e = 0
     // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
+    CC_.assign(N + 1, nullptr);
+    DD_.assign(N + 1, nullptr);
+    llg_.assign(N + 1, nullptr);
+    uug_.assign(N + 1, nullptr);
 
     if (constraints != nullptr) {
       auto& constr = *constraints;
-      boundData.resize(N + 1);
+      boundData_.resize(N + 1);
 
       // k = 0, eliminate initial state
       // numState[0] = 0 --> No need to specify C[0] here
       if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+        boundData_[0] = -constr[0].f;
+        boundData_[0].noalias() -= constr[0].dfdx * x0;
+        llg_[0] = boundData_[0].data();
+        uug_[0] = boundData_[0].data();
+        DD_[0] = constr[0].dfdu.data();
       }
 
       // k = 1 -> (N-1)
       for (int k = 1; k < N; k++) {
         if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+          CC_[k] = constr[k].dfdx.data();
+          DD_[k] = constr[k].dfdu.data();
+          boundData_[k] = -constr[k].f;
+          llg_[k] = boundData_[k].data();
+          uug_[k] = boundData_[k].data();
         }
       }
 
       // k = N, no inputs
       if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+        CC_[N] = constr[N].dfdx.data();
+        boundData_[N] = -constr[N].f;
+        llg_[N] = boundData_[N].data();
+        uug_[N] = boundData_[N].data();
       }
     }
 
@@ -279,8 +280,8 @@ class HpipmInterface::Impl {
     scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    d_ocp_qp_set_all(AA_.data(), BB_.data(), bb_.data(), QQ_.data(), SS_.data(), RR_.data(), qq_.data(), rr_.data(), hidxbx, hlbx, hubx,
+                     hidxbu, hlbu, hubu, CC_.data(), DD_.data(), llg_.data(), uug_.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
 
     if (verbose) {
@@ -300,6 +301,46 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  void getSolution(Solution& solution) {
+    const int N = ocpSize_.numStages;
+    solution.stateTrajectory.resize(N + 1);
+    solution.inputTrajectory.resize(N);
+    for (int k = 0; k < (N + 1); ++k) {
+      solution.stateTrajectory[k].resize(ocpSize_.numStates[k]);
+      d_ocp_qp_sol_get_x(k, &qpSol_, solution.stateTrajectory[k].data());
+      if (k < N) {
+        solution.inputTrajectory[k].resize(ocpSize_.numInputs[k]);
+        d_ocp_qp_sol_get_u(k, &qpSol_, solution.inputTrajectory[k].data());
+      }
+    }
+  }
+
+  void setInitialGuess(const Solution& guess) {
+    const int N = ocpSize_.numStages;
+
+    // Nodes without a consistent guess start from zero. HPIPM only reads the guess, but takes non-const pointers.
+    const auto maxSize = std::max(*std::max_element(ocpSize_.numStates.begin(), ocpSize_.numStates.end()),
+                                  *std::max_element(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end()));
+    zeros_.setZero(maxSize);
+    auto guessOrZeros = [&](const vector_array_t& trajectory, int k, int size) {
+      return (k < static_cast<int>(trajectory.size()) && trajectory[k].size() == size) ? const_cast<scalar_t*>(trajectory[k].data())
+                                                                                      : zeros_.data();
+    };
+
+    for (int k = 0; k < (N + 1); ++k) {
+      d_ocp_qp_sol_set_x(k, guessOrZeros(guess.stateTrajectory, k, ocpSize_.numStates[k]), &qpSol_);
+      if (k < N) {
+        d_ocp_qp_sol_set_u(k, guessOrZeros(guess.inputTrajectory, k, ocpSize_.numInputs[k]), &qpSol_);
+      }
+    }
+  }
+
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    return iter;
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -504,8 +545,19 @@ class HpipmInterface::Impl {
 
  private:
   Settings settings_;
+  OcpSize requestedOcpSize_;  // Size as passed to initializeMemory(), including the initial state
   OcpSize ocpSize_;
 
+  // Problem data passed to HPIPM, kept such that repeated solves of the same size do not allocate.
+  // The bounds are stored here to keep the data alive while HPIPM has the pointers.
+  std::vector<scalar_t*> AA_, BB_, bb_;
+  std::vector<scalar_t*> QQ_, RR_, SS_, qq_, rr_;
+  std::vector<scalar_t*> CC_, DD_, llg_, uug_;
+  vector_t b0_;
+  vector_t r0_;
+  vector_array_t boundData_;
+  vector_t zeros_;
+
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
 
@@ -522,13 +574,12 @@ class HpipmInterface::Impl {
   d_ocp_qp_ipm_ws workspace_;
 };
 
-HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
-    : pImpl_(new HpipmInterface::Impl(std::move(ocpSize), settings)) {}
+HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings) : pImpl_(new HpipmInterface::Impl(ocpSize, settings)) {}
 
 HpipmInterface::~HpipmInterface() = default;
 
-void HpipmInterface::resize(OcpSize ocpSize) {
-  pImpl_->initializeMemory(std::move(ocpSize));
+void HpipmInterface::resize(const OcpSize& ocpSize) {
+  pImpl_->initializeMemory(ocpSize);
 }
 
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
@@ -538,6 +589,18 @@ hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctio
   return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
 }
 
+void HpipmInterface::getSolution(Solution& solution) const {
+  pImpl_->getSolution(solution);
+}
+
+void HpipmInterface::setInitialGuess(const Solution& guess) {
+  pImpl_->setInitialGuess(guess);
+}
+
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
+}
+
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                                      const ScalarFunctionQuadraticApproximation& cost0) {
   return pImpl_->getRiccatiCostToGo(dynamics0, cost0);
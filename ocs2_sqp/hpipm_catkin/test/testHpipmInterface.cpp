@@ -205,6 +205,55 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, warmStart) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+
+  // Cold start, with a tolerance that makes the solution independent of the initialization
+  ocs2::HpipmInterface::Settings settings;
+  settings.tol_stat = 1e-8;
+  ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSol, uSol), hpipm_status::SUCCESS);
+  ocs2::HpipmInterface::Solution solution;
+  hpipmInterface.getSolution(solution);
+  for (int k = 1; k < (N + 1); k++) {  // The initial state is not a decision variable of HPIPM
+    ASSERT_TRUE(solution.stateTrajectory[k].isApprox(xSol[k]));
+  }
+  ASSERT_TRUE(ocs2::isEqual(solution.inputTrajectory, uSol));
+
+  // Warm start from the primal solution
+  settings.warm_start = 1;
+  ocs2::HpipmInterface warmStartInterface(ocpSize, settings);
+  warmStartInterface.setInitialGuess(solution);
+  std::vector<ocs2::vector_t> xSolWarm;
+  std::vector<ocs2::vector_t> uSolWarm;
+  ASSERT_EQ(warmStartInterface.solve(x0, system, cost, &constraints, xSolWarm, uSolWarm), hpipm_status::SUCCESS);
+
+  // Same solution. The number of iterations depends on the HPIPM version, and is not compared.
+  ASSERT_TRUE(ocs2::isEqual(xSolWarm, xSol, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSolWarm, uSol, 1e-6));
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
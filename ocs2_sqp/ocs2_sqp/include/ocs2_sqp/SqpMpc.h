@@ -48,7 +48,7 @@ class SqpMpc final : public MPC_BASE {
    */
   SqpMpc(mpc::Settings mpcSettings, sqp::Settings settings, const OptimalControlProblem& optimalControlProblem,
          const Initializer& initializer)
-      : MPC_BASE(std::move(mpcSettings)) {
+      : MPC_BASE(std::move(mpcSettings)), realTimeIteration_(settings.realTimeIteration) {
     solverPtr_.reset(new SqpSolver(std::move(settings), optimalControlProblem, initializer));
   };
 
@@ -57,16 +57,41 @@ class SqpMpc final : public MPC_BASE {
   SqpSolver* getSolverPtr() override { return solverPtr_.get(); }
   const SqpSolver* getSolverPtr() const override { return solverPtr_.get(); }
 
+  /**
+   * In the real-time iteration mode, linearizes the problem for the expected time of the next observation. Without mpcDesiredFrequency,
+   * this time is only known after two runs. Until then, run() prepares the linearization itself.
+   */
+  void prepareNextRun() override {
+    if (realTimeIteration_ && !isFirstMpcRun()) {
+      const scalar_t expectedPeriod = (settings().mpcDesiredFrequency_ > 0.0) ? 1.0 / settings().mpcDesiredFrequency_ : lastRunPeriod_;
+      if (expectedPeriod > 0.0) {
+        const scalar_t nextInitTime = lastInitTime_ + expectedPeriod;
+        solverPtr_->prepareRun(nextInitTime, lastInitState_, nextInitTime + getTimeHorizon());
+      }
+    }
+  }
+
  protected:
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
       solverPtr_->reset();
     }
     solverPtr_->run(initTime, initState, finalTime);
+
+    // No period is known after the first run, also after an MPC reset
+    lastRunPeriod_ = isFirstMpcRun() ? 0.0 : initTime - lastInitTime_;
+    lastInitTime_ = initTime;
+    lastInitState_ = initState;
   }
 
  private:
   std::unique_ptr<SqpSolver> solverPtr_;
+
+  // Real-time iteration
+  const bool realTimeIteration_;
+  scalar_t lastInitTime_ = 0.0;
+  scalar_t lastRunPeriod_ = 0.0;  // time between the last two observations
+  vector_t lastInitState_;
 };
 
 }  // namespace ocs2
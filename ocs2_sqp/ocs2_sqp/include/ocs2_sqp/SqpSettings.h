@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
+#include <ocs2_oc/multiple_shooting/NodeScheduler.h>
+
 #include <hpipm_catkin/HpipmInterfaceSettings.h>
 
 namespace ocs2 {
@@ -39,13 +41,22 @@ namespace sqp {
 
 struct Settings {
   // Sqp settings
-  size_t sqpIteration = 10;  // Maximum number of SQP iterations
-  scalar_t deltaTol = 1e-6;  // Termination condition : RMS update of x(t) and u(t) are both below this value
-  scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
+  size_t sqpIteration = 10;        // Maximum number of SQP iterations
+  scalar_t deltaTol = 1e-6;        // Termination condition : RMS update of x(t) and u(t) are both below this value
+  scalar_t costTol = 1e-4;         // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
+  bool realTimeIteration = false;  // Real-time iteration: a run() only embeds the initial state and takes one full QP step
+
+  // Inexact linearization: an intermediate node keeps its sensitivities while its state and input moved less than this threshold
+  // (in norm) since they were computed. Only the residuals of such a node are evaluated. 0: re-linearize all nodes in every iteration
+  scalar_t relinearizationThreshold = 0.0;
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;      // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;       // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchBatchSize = 1;  // number of step sizes {alpha, alpha * alpha_decay, ...} evaluated in parallel. 1: serial linesearch
+  // Linearize the full step of the serial linesearch, to be reused by the next iteration if accepted. The linearization is wasted if
+  // the full step is rejected, see SqpSolver::getNumRejectedFullStepLinearizations(). Only available in the SQP solver
+  bool linearizeFullStep = false;
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -79,6 +90,10 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::vector<int> threadAffinity;  // CPU cores of the worker threads, see ThreadPool
+  // Distribution of the nodes among the threads (DYNAMIC, BLOCK, COST_AWARE) and number of consecutive nodes claimed at once
+  multiple_shooting::NodeSchedulingStrategy nodeScheduling = multiple_shooting::NodeSchedulingStrategy::DYNAMIC;
+  size_t nodeSchedulingGrainSize = 1;
 };
 
 /**
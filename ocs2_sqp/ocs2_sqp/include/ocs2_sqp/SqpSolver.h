@@ -31,10 +31,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/AllocationCounter.h>
 #include <ocs2_core/misc/Benchmark.h>
-#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkerTeam.h>
 
+#include <ocs2_oc/multiple_shooting/NodeScheduler.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/SpeculativeLinesearch.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -70,6 +74,15 @@ class SqpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Number of intermediate nodes that kept their linearization since the last reset, see settings.relinearizationThreshold. */
+  size_t getNumSkippedLinearizations() const { return totalNumSkippedLinearizations_; }
+
+  /** Number of full steps that were linearized in the linesearch but rejected since the last reset, see settings.linearizeFullStep. */
+  size_t getNumRejectedFullStepLinearizations() const { return totalNumRejectedFullStepLinearizations_; }
+
+  /** Number of interior point iterations of HPIPM since the last reset. */
+  size_t getNumQpIterations() const { return totalNumQpIterations_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -90,6 +103,12 @@ class SqpSolver : public SolverBase {
     throw std::runtime_error("[SqpSolver] getIntermediateDualSolution() not available yet.");
   }
 
+  /**
+   * Whether the linearization of a preparation phase (prepareRun() with settings.realTimeIteration) can be used by a run() with the
+   * given horizon. This requires initial and final times within dt/2 of the prepared ones and unchanged references.
+   */
+  bool isRealTimeIterationPrepared(scalar_t initTime, scalar_t finalTime) const;
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -108,11 +127,30 @@ class SqpSolver : public SolverBase {
     primalSolution_.inputTrajectory_ = primalSolution.inputTrajectory_;
     primalSolution_.postEventIndices_ = primalSolution.postEventIndices_;
     primalSolution_.modeSchedule_ = primalSolution.modeSchedule_;
+    realTimeIterationPrepared_ = false;
     runImpl(initTime, initState, finalTime);
   }
 
+  void prepareRunImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    if (settings_.realTimeIteration) {
+      prepareRealTimeIteration(initTime, initState, finalTime);
+    }
+  }
+
+  /**
+   * Preparation phase of the real-time iteration: linearizes the problem around the previous solution, shifted to the given horizon.
+   * The initial state is only used if the previous solution does not cover initTime.
+   */
+  void prepareRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  /** Feedback phase of the real-time iteration: embeds the initial state in the prepared QP and takes its full step */
+  void runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
   /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction) {
+    workerTeam_.run(std::forward<Functor>(taskFunction));
+  }
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -121,17 +159,42 @@ class SqpSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, std::vector<Metrics>& metrics);
 
+  /** Invalidates the kept linearizations of the intermediate nodes, e.g. when the time discretization or the references change */
+  void resetLinearizations() { std::fill(hasLinearization_.begin(), hasLinearization_.end(), 0); }
+
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                       const vector_array_t& u, std::vector<Metrics>& metrics);
 
+  /**
+   * Same as computePerformance, but evaluates the intermediate nodes with their derivatives. The linearization is kept in
+   * transcriptions_, such that setupQuadraticSubproblem() can reuse it when the step is accepted.
+   */
+  PerformanceIndex computePerformanceWithLinearization(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                       const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics);
+
+  /** Computes the performance metrics of node i, without the initial state constraint */
+  PerformanceIndex computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, int i,
+                                          const vector_array_t& x, const vector_array_t& u, Metrics& metrics);
+
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;      // delta_x(t)
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  OcpSubproblemSolution getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
+
+  /**
+   * Seeds HPIPM with the primal solution of the previous QP, shifted to the given time discretization (see hpipm warm_start = 1).
+   * Without a previous QP, the guess is zero.
+   */
+  void setQpInitialGuess(const std::vector<AnnotatedTime>& time);
+
+  /**
+   * Keeps the part of the previous QP step that was not taken by the step of the given size as the primal guess of the next QP.
+   */
+  void updateQpWarmStart(scalar_t stepSize);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
@@ -144,6 +207,11 @@ class SqpSolver : public SolverBase {
                          const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u,
                          std::vector<Metrics>& metrics);
 
+  /** Same as takeStep, but evaluates settings.linesearchBatchSize step sizes concurrently */
+  sqp::StepInfo takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                    const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                    vector_array_t& u, std::vector<Metrics>& metrics);
+
   /** Determine convergence after a step */
   sqp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const;
 
@@ -157,9 +225,16 @@ class SqpSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  OcpSize ocpSize_;  // Size of the last QP, reused such that the size extraction does not allocate
 
   // Threading
-  ThreadPool threadPool_;
+  WorkerTeam workerTeam_;
+  multiple_shooting::NodeScheduler linearizationScheduler_;
+  multiple_shooting::NodeScheduler performanceScheduler_;
+  multiple_shooting::SpeculativeLinesearch speculativeLinesearch_;
+  std::vector<vector_array_t> candidateStates_;  // state trajectories of the speculative linesearch candidates
+  std::vector<vector_array_t> candidateInputs_;  // input trajectories of the speculative linesearch candidates
+  std::vector<std::vector<Metrics>> candidateMetrics_;  // metrics of the speculative linesearch candidates
 
   // Solution
   PrimalSolution primalSolution_;
@@ -175,9 +250,37 @@ class SqpSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Transcription of the intermediate nodes. It is kept across iterations and MPC calls, such that the memory of a node is reused.
+  std::vector<multiple_shooting::Transcription> transcriptions_;
+  bool transcriptionsAtIterate_{false};  // true if transcriptions_ hold the linearization of the current iterate (see linearizeFullStep)
+
+  // Inexact linearization: unprojected transcription of each intermediate node and the point it was computed at (see
+  // relinearizationThreshold). int instead of bool, since the flags of different nodes are written concurrently.
+  std::vector<multiple_shooting::Transcription> linearizations_;
+  vector_array_t linearizationStates_;
+  vector_array_t linearizationInputs_;
+  std::vector<int> hasLinearization_;
+  std::vector<size_t> numSkippedLinearizations_;  // per worker, in the current linearization
+
+  // Warm start of the QPs with constraints passed to HPIPM: primal solution of the last QP in the variables of HPIPM, scaled to the part
+  // of the step not taken yet
+  scalar_array_t qpWarmStartTime_;
+  HpipmInterface::Solution qpWarmStart_;
+
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Real-time iteration: references, linearization point and metrics of the preparation phase. The QP is stored in the LQ
+  // approximation above.
+  bool realTimeIterationPrepared_{false};
+  std::vector<AnnotatedTime> realTimeIterationTime_;
+  ModeSchedule realTimeIterationModeSchedule_;
+  TargetTrajectories realTimeIterationTargetTrajectories_;
+  vector_array_t realTimeIterationX_;
+  vector_array_t realTimeIterationU_;
+  std::vector<Metrics> realTimeIterationMetrics_;
+  PerformanceIndex realTimeIterationPerformance_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -186,11 +289,22 @@ class SqpSolver : public SolverBase {
 
   // Benchmarking
   size_t totalNumIterations_{0};
+  size_t totalNumIntermediateNodes_{0};
+  size_t totalNumSkippedLinearizations_{0};
+  size_t totalNumFullStepLinearizations_{0};
+  size_t totalNumRejectedFullStepLinearizations_{0};
+  size_t totalNumQpIterations_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
   benchmark::RepeatedTimer linesearchTimer_;
   benchmark::RepeatedTimer computeControllerTimer_;
+
+  // Heap allocations per phase, only counted if ocs2_core_allocation_hooks is linked in
+  benchmark::RepeatedAllocationCounter linearQuadraticApproximationAllocations_;
+  benchmark::RepeatedAllocationCounter solveQpAllocations_;
+  benchmark::RepeatedAllocationCounter linesearchAllocations_;
+  benchmark::RepeatedAllocationCounter computeControllerAllocations_;
 };
 
 }  // namespace ocs2
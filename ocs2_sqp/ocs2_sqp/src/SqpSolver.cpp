@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -56,7 +57,13 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      workerTeam_(std::max(settings_.nThreads, size_t(1)), settings_.threadPriority, settings_.threadAffinity),
+      linearizationScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      performanceScheduler_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      speculativeLinesearch_(settings_.nodeScheduling, workerTeam_.size(), settings_.nodeSchedulingGrainSize),
+      candidateStates_(settings_.linesearchBatchSize),
+      candidateInputs_(settings_.linesearchBatchSize),
+      candidateMetrics_(settings_.linesearchBatchSize) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -65,9 +72,7 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
   // Clone objects to have one for each worker
-  for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
-  }
+  workerTeam_.makeLocalCopies(optimalControlProblem, ocpDefinitions_, settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -90,13 +95,26 @@ void SqpSolver::reset() {
   primalSolution_ = PrimalSolution();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  realTimeIterationPrepared_ = false;
+  resetLinearizations();
+  qpWarmStartTime_.clear();
+  qpWarmStart_ = HpipmInterface::Solution();
 
   // reset timers
   totalNumIterations_ = 0;
+  totalNumIntermediateNodes_ = 0;
+  totalNumSkippedLinearizations_ = 0;
+  totalNumFullStepLinearizations_ = 0;
+  totalNumRejectedFullStepLinearizations_ = 0;
+  totalNumQpIterations_ = 0;
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  linearQuadraticApproximationAllocations_.reset();
+  solveQpAllocations_.reset();
+  linesearchAllocations_.reset();
+  computeControllerAllocations_.reset();
 }
 
 std::string SqpSolver::getBenchmarkingInformation() const {
@@ -121,6 +139,26 @@ std::string SqpSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    if (totalNumIntermediateNodes_ > 0) {
+      const auto numSkippedPerIteration =
+          static_cast<scalar_t>(totalNumSkippedLinearizations_) / linearQuadraticApproximationTimer_.getNumTimedIntervals();
+      infoStream << "SQP Linearization\t   :\tAverage skipped nodes (% of intermediate nodes)\n";
+      infoStream << "\tSkipped Nodes      :\t" << numSkippedPerIteration << " \t\t\t("
+                 << static_cast<scalar_t>(totalNumSkippedLinearizations_) / totalNumIntermediateNodes_ * inPercent << "%)\n";
+    }
+    if (totalNumFullStepLinearizations_ > 0) {
+      infoStream << "SQP Full Steps\t   :\tRejected linearized full steps (% of linearized full steps)\n";
+      infoStream << "\tRejected Steps     :\t" << totalNumRejectedFullStepLinearizations_ << " \t\t\t("
+                 << static_cast<scalar_t>(totalNumRejectedFullStepLinearizations_) / totalNumFullStepLinearizations_ * inPercent
+                 << "%)\n";
+    }
+    if (benchmark::isAllocationCounterInstalled()) {
+      infoStream << "SQP Allocations\t   :\tAverage heap allocations per call (average memory)\n";
+      infoStream << "\tLQ Approximation   :\t" << benchmark::toString(linearQuadraticApproximationAllocations_) << "\n";
+      infoStream << "\tSolve QP           :\t" << benchmark::toString(solveQpAllocations_) << "\n";
+      infoStream << "\tLinesearch         :\t" << benchmark::toString(linesearchAllocations_) << "\n";
+      infoStream << "\tCompute Controller :\t" << benchmark::toString(computeControllerAllocations_) << "\n";
+    }
   }
   return infoStream.str();
 }
@@ -155,6 +193,11 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
 }
 
 void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  if (settings_.realTimeIteration) {
+    runRealTimeIteration(initTime, initState, finalTime);
+    return;
+  }
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -183,6 +226,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   // Bookkeeping
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
+  transcriptionsAtIterate_ = false;
+  resetLinearizations();
 
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
@@ -192,20 +237,27 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     }
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
+    linearQuadraticApproximationAllocations_.startCounter();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
+    linearQuadraticApproximationAllocations_.endCounter();
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve QP
     solveQpTimer_.startTimer();
+    solveQpAllocations_.startCounter();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
     extractValueFunction(timeDiscretization, x);
+    solveQpAllocations_.endCounter();
     solveQpTimer_.endTimer();
 
     // Apply step
     linesearchTimer_.startTimer();
+    linesearchAllocations_.startCounter();
     const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u, metrics);
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
+    updateQpWarmStart(stepInfo.stepSize);
+    linesearchAllocations_.endCounter();
     linesearchTimer_.endTimer();
 
     // Check convergence
@@ -217,8 +269,10 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 
   computeControllerTimer_.startTimer();
+  computeControllerAllocations_.startCounter();
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  computeControllerAllocations_.endCounter();
   computeControllerTimer_.endTimer();
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -229,11 +283,112 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+void SqpSolver::prepareRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  linearQuadraticApproximationTimer_.startTimer();
+  linearQuadraticApproximationAllocations_.startCounter();
+
+  // Keep the references of the linearization to detect an update before the feedback phase
+  realTimeIterationModeSchedule_ = this->getReferenceManager().getModeSchedule();
+  realTimeIterationTargetTrajectories_ = this->getReferenceManager().getTargetTrajectories();
+
+  // Determine time discretization, taking into account event times.
+  realTimeIterationTime_ = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, realTimeIterationModeSchedule_.eventTimes);
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  // Shift the previous solution to the new horizon
+  if (!primalSolution_.timeTrajectory_.empty()) {
+    std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
+  }
+  multiple_shooting::initializeStateInputTrajectories(initState, realTimeIterationTime_, primalSolution_, *initializerPtr_,
+                                                      realTimeIterationX_, realTimeIterationU_);
+
+  // Make QP approximation. The initial state constraint is added in the feedback phase.
+  // The linearizations kept from the previous horizon do not apply to the new time discretization.
+  transcriptionsAtIterate_ = false;
+  resetLinearizations();
+  realTimeIterationPerformance_ = setupQuadraticSubproblem(realTimeIterationTime_, realTimeIterationX_.front(), realTimeIterationX_,
+                                                           realTimeIterationU_, realTimeIterationMetrics_);
+  realTimeIterationPrepared_ = true;
+
+  linearQuadraticApproximationAllocations_.endCounter();
+  linearQuadraticApproximationTimer_.endTimer();
+}
+
+bool SqpSolver::isRealTimeIterationPrepared(scalar_t initTime, scalar_t finalTime) const {
+  if (!realTimeIterationPrepared_) {
+    return false;
+  }
+
+  // The first and last node are moved to the actual horizon, without passing their neighbours
+  const auto& time = realTimeIterationTime_;
+  const bool sameHorizon = std::abs(initTime - time.front().time) <= 0.5 * settings_.dt && initTime < time[1].time &&
+                           std::abs(finalTime - time.back().time) <= 0.5 * settings_.dt && finalTime > time[time.size() - 2].time;
+
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  const bool sameReferences = realTimeIterationModeSchedule_.eventTimes == modeSchedule.eventTimes &&
+                              realTimeIterationModeSchedule_.modeSequence == modeSchedule.modeSequence &&
+                              realTimeIterationTargetTrajectories_ == this->getReferenceManager().getTargetTrajectories();
+
+  return sameHorizon && sameReferences;
+}
+
+void SqpSolver::runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  if (settings_.printSolverStatus || settings_.printLinesearch) {
+    std::cerr << "\n+++++++++++++ SQP real-time iteration ++++++++++++++++\n";
+  }
+
+  if (!isRealTimeIterationPrepared(initTime, finalTime)) {
+    prepareRealTimeIteration(initTime, initState, finalTime);
+  }
+  realTimeIterationPrepared_ = false;
+
+  // The prepared QP is solved as is, but the policy starts at the actual initial time
+  auto& timeDiscretization = realTimeIterationTime_;
+  timeDiscretization.front().time = initTime;
+  timeDiscretization.back().time = finalTime;
+  auto& x = realTimeIterationX_;
+  auto& u = realTimeIterationU_;
+  auto& metrics = realTimeIterationMetrics_;
+
+  // Solve QP with the measured initial state
+  solveQpTimer_.startTimer();
+  solveQpAllocations_.startCounter();
+  const vector_t delta_x0 = initState - x[0];
+  const auto deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
+  extractValueFunction(timeDiscretization, x);
+  solveQpAllocations_.endCounter();
+  solveQpTimer_.endTimer();
+
+  // Apply the full step. The performance is the one of the linearization point with the measured initial state, the performance of
+  // the new iterate is only known after the next preparation phase.
+  linesearchTimer_.startTimer();
+  linesearchAllocations_.startCounter();
+  metrics.front().dynamicsViolation += delta_x0;
+  realTimeIterationPerformance_.dynamicsViolationSSE += delta_x0.squaredNorm();
+  performanceIndeces_.clear();
+  performanceIndeces_.push_back(realTimeIterationPerformance_);
+  multiple_shooting::incrementTrajectory(x, deltaSolution.deltaXSol, 1.0, x);
+  multiple_shooting::incrementTrajectory(u, deltaSolution.deltaUSol, 1.0, u);
+  updateQpWarmStart(1.0);
+  linesearchAllocations_.endCounter();
+  linesearchTimer_.endTimer();
+
+  ++totalNumIterations_;
+
+  computeControllerTimer_.startTimer();
+  computeControllerAllocations_.startCounter();
+  primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  computeControllerAllocations_.endCounter();
+  computeControllerTimer_.endTimer();
 }
 
-SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
+SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0) {
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -241,13 +396,26 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   hpipm_status status;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
   if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
+    // Only QPs with constraints passed to HPIPM take interior point iterations, and are warm started. These are the state-input
+    // equality constraints, which HPIPM treats as inequality constraints with equal lower and upper bounds.
+    extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_, ocpSize_);
+    hpipmInterface_.resize(ocpSize_);
+    if (settings_.hpipmSettings.warm_start == 1) {
+      setQpInitialGuess(time);
+    }
     status =
         hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    if (settings_.hpipmSettings.warm_start == 1) {
+      qpWarmStartTime_.resize(time.size());
+      std::transform(time.begin(), time.end(), qpWarmStartTime_.begin(), [](const AnnotatedTime& t) { return t.time; });
+      hpipmInterface_.getSolution(qpWarmStart_);
+    }
   } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
+    extractSizesFromProblem(dynamics_, cost_, nullptr, ocpSize_);
+    hpipmInterface_.resize(ocpSize_);
     status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
   }
+  totalNumQpIterations_ += hpipmInterface_.getNumIterations();
 
   if (status != hpipm_status::SUCCESS) {
     throw std::runtime_error("[SqpSolver] Failed to solve QP");
@@ -264,6 +432,41 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   return solution;
 }
 
+void SqpSolver::setQpInitialGuess(const std::vector<AnnotatedTime>& time) {
+  if (qpWarmStartTime_.empty()) {
+    // Start from zero instead of the solution of an unrelated QP that HPIPM still holds
+    hpipmInterface_.setInitialGuess(HpipmInterface::Solution());
+    return;
+  }
+
+  // Node i takes the guess of the first previous node at or after it. Within a run, the time discretization is the same and this is
+  // the identity. Across MPC calls, it shifts the previous solution by the amount of nodes the horizon moved and repeats its last node.
+  const int N = static_cast<int>(time.size()) - 1;
+  const int previousN = static_cast<int>(qpWarmStartTime_.size()) - 1;
+  HpipmInterface::Solution guess;
+  guess.stateTrajectory.resize(N + 1);
+  guess.inputTrajectory.resize(N);
+  for (int i = 0; i <= N; ++i) {
+    const auto j = std::lower_bound(qpWarmStartTime_.begin(), qpWarmStartTime_.end(), time[i].time) - qpWarmStartTime_.begin();
+    const auto node = std::min<int>(j, previousN);
+    guess.stateTrajectory[i] = qpWarmStart_.stateTrajectory[node];
+    if (i < N) {
+      guess.inputTrajectory[i] = qpWarmStart_.inputTrajectory[std::min<int>(j, previousN - 1)];
+    }
+  }
+  // Guesses of inconsistent size, e.g. around events, are replaced by zero
+  hpipmInterface_.setInitialGuess(guess);
+}
+
+void SqpSolver::updateQpWarmStart(scalar_t stepSize) {
+  for (auto& dx : qpWarmStart_.stateTrajectory) {
+    dx *= 1.0 - stepSize;
+  }
+  for (auto& du : qpWarmStart_.inputTrajectory) {
+    du *= 1.0 - stepSize;
+  }
+}
+
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
     valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
@@ -302,17 +505,41 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  transcriptions_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
+  // The intermediate nodes might already be linearized by the linesearch
+  const bool reuseTranscriptions = transcriptionsAtIterate_;
+  transcriptionsAtIterate_ = false;
+
+  // Inexact linearization: nodes close to their last linearization only update the residuals
+  const bool keepLinearizations = settings_.relinearizationThreshold > 0.0;
+  if (keepLinearizations) {
+    linearizations_.resize(N);
+    linearizationStates_.resize(N);
+    linearizationInputs_.resize(N);
+    hasLinearization_.resize(N, 0);
+  }
+  numSkippedLinearizations_.assign(settings_.nThreads, 0);
+
+  linearizationScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
+    size_t workerNumSkipped = 0;
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    linearizationScheduler_.forEachNode(workerId, [&](int i) {
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+        metrics[i] = multiple_shooting::computeMetrics(result);
+        workerPerformance += multiple_shooting::computePerformanceIndex(result);
+        cost_[i] = std::move(result.cost);
+        stateInputEqConstraints_[i].resize(0, x[i].size());
+        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
         metrics[i] = multiple_shooting::computeMetrics(result);
@@ -328,39 +555,54 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        auto& result = transcriptions_[i];
+        const bool skipLinearization = !reuseTranscriptions && keepLinearizations && hasLinearization_[i] != 0 &&
+                                       (x[i] - linearizationStates_[i]).norm() < settings_.relinearizationThreshold &&
+                                       (u[i] - linearizationInputs_[i]).norm() < settings_.relinearizationThreshold;
+        if (skipLinearization) {
+          result = linearizations_[i];
+          multiple_shooting::updateIntermediateNodeResiduals(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+          ++workerNumSkipped;
+        } else {
+          if (!reuseTranscriptions) {
+            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+          }
+          if (keepLinearizations) {
+            linearizations_[i] = result;
+            linearizationStates_[i] = x[i];
+            linearizationInputs_[i] = u[i];
+            hasLinearization_[i] = 1;
+          }
+        }
         metrics[i] = multiple_shooting::computeMetrics(result);
         workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
         if (settings_.projectStateInputEqualityConstraints) {
           multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
         }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+        // Swap instead of move, such that the transcription keeps the memory of the previous iteration
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+        std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
-      stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-    }
+    });
 
     // Accumulate! Same worker might run multiple tasks
     performance[workerId] += workerPerformance;
+    numSkippedLinearizations_[workerId] += workerNumSkipped;
   };
   runParallel(std::move(parallelTask));
 
+  // Count the intermediate nodes and those that kept their linearization
+  if (keepLinearizations) {
+    totalNumIntermediateNodes_ += std::count_if(time.begin(), std::prev(time.end()),
+                                                [](const AnnotatedTime& t) { return t.event != AnnotatedTime::Event::PreEvent; });
+    totalNumSkippedLinearizations_ += std::accumulate(numSkippedLinearizations_.begin(), numSkippedLinearizations_.end(), size_t(0));
+  }
+
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
   metrics.front().dynamicsViolation += initDynamicsViolation;
@@ -380,33 +622,55 @@ PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>&
   metrics.resize(N + 1);
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  performanceScheduler_.reset(N + 1);
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
+    performanceScheduler_.forEachNode(
+        workerId, [&](int i) { performance[workerId] += computeNodePerformance(ocpDefinition, time, i, x, u, metrics[i]); });
+  };
+  runParallel(std::move(parallelTask));
+
+  // Account for initial state in performance
+  const vector_t initDynamicsViolation = initState - x.front();
+  metrics.front().dynamicsViolation += initDynamicsViolation;
+  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+  // Sum performance of the threads
+  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+  return totalPerformance;
+}
+
+PerformanceIndex SqpSolver::computePerformanceWithLinearization(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                               const vector_array_t& x, const vector_array_t& u,
+                                                               std::vector<Metrics>& metrics) {
+  // Problem size
+  const int N = static_cast<int>(time.size()) - 1;
+  metrics.resize(N + 1);
+  transcriptions_.resize(N);
+
+  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  linearizationScheduler_.reset(N + 1);
+  auto parallelTask = [&](int workerId) {
+    // Get worker specific resources
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+
+    linearizationScheduler_.forEachNode(workerId, [&](int i) {
+      if (i < N && time[i].event != AnnotatedTime::Event::PreEvent) {
+        // Normal, intermediate node: the metrics are extracted from the linearization
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
+        auto& result = transcriptions_[i];
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+        metrics[i] = multiple_shooting::computeMetrics(result);
+        performance[workerId] += multiple_shooting::computePerformanceIndex(result, dt);
+      } else {
+        // Terminal and event nodes are linearized again in setupQuadraticSubproblem
+        performance[workerId] += computeNodePerformance(ocpDefinition, time, i, x, u, metrics[i]);
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
-    }
+    });
   };
   runParallel(std::move(parallelTask));
 
@@ -421,11 +685,36 @@ PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>&
   return totalPerformance;
 }
 
+PerformanceIndex SqpSolver::computeNodePerformance(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time, int i,
+                                                   const vector_array_t& x, const vector_array_t& u, Metrics& metrics) {
+  const int N = static_cast<int>(time.size()) - 1;
+  if (i == N) {
+    // Terminal node
+    const scalar_t tN = getIntervalStart(time[N]);
+    metrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+    return toPerformanceIndex(metrics);
+  } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    metrics = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+    return toPerformanceIndex(metrics);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    metrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+    return toPerformanceIndex(metrics, dt);
+  }
+}
+
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.linesearchBatchSize > 1) {
+    return takeSpeculativeStep(baseline, timeDiscretization, initState, subproblemSolution, x, u, metrics);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -450,13 +739,19 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   vector_array_t xNew(x.size());
   vector_array_t uNew(u.size());
   std::vector<Metrics> metricsNew(metrics.size());
+  bool linearizeStep = settings_.linearizeFullStep;
   do {
     // Compute step
     multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
     multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
 
-    // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
+    // Compute cost and constraints. The full step is linearized as well, to be reused by the next iteration if it is accepted.
+    const bool stepLinearized = linearizeStep;
+    linearizeStep = false;
+    totalNumFullStepLinearizations_ += stepLinearized ? 1 : 0;
+    const PerformanceIndex performanceNew = stepLinearized
+                                                ? computePerformanceWithLinearization(timeDiscretization, initState, xNew, uNew, metricsNew)
+                                                : computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
 
     // Step acceptance and record step type
     bool stepAccepted;
@@ -475,6 +770,7 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
       x = std::move(xNew);
       u = std::move(uNew);
       metrics = std::move(metricsNew);
+      transcriptionsAtIterate_ = stepLinearized;
 
       // Prepare step info
       sqp::StepInfo stepInfo;
@@ -487,6 +783,7 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
       return stepInfo;
 
     } else {  // Try smaller step
+      totalNumRejectedFullStepLinearizations_ += stepLinearized ? 1 : 0;
       alpha *= settings_.alpha_decay;
 
       // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
@@ -516,6 +813,82 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   return stepInfo;
 }
 
+sqp::StepInfo SqpSolver::takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                             const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                             vector_array_t& u, std::vector<Metrics>& metrics) {
+  using StepType = FilterLinesearch::StepType;
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  const auto stepSizes = multiple_shooting::SpeculativeLinesearch::getStepSizes(1.0, settings_.alpha_decay, settings_.alpha_min,
+                                                                                settings_.deltaTol, deltaXnorm, deltaUnorm);
+  const int numNodes = static_cast<int>(timeDiscretization.size());
+  const size_t batchSize = std::min(settings_.linesearchBatchSize, stepSizes.size());
+  // The candidate buffers keep their memory across iterations, resizing is a no-op once the horizon is stable
+  auto& xNew = candidateStates_;
+  auto& uNew = candidateInputs_;
+  auto& metricsNew = candidateMetrics_;
+  for (size_t c = 0; c < batchSize; c++) {
+    xNew[c].resize(x.size());
+    uNew[c].resize(u.size());
+    metricsNew[c].resize(numNodes);
+  }
+
+  const int accepted = speculativeLinesearch_.backtrack(
+      workerTeam_, filterLinesearch_, baseline, subproblemSolution.armijoDescentMetric, stepSizes, batchSize, numNodes,
+      [&](int c, scalar_t alpha) {
+        multiple_shooting::incrementTrajectory(u, du, alpha, uNew[c]);
+        multiple_shooting::incrementTrajectory(x, dx, alpha, xNew[c]);
+      },
+      [&](int workerId, int c, int i) {
+        auto performance = computeNodePerformance(ocpDefinitions_[workerId], timeDiscretization, i, xNew[c], uNew[c], metricsNew[c][i]);
+        if (i == 0) {
+          // Account for initial state in performance
+          const vector_t initDynamicsViolation = initState - xNew[c].front();
+          metricsNew[c].front().dynamicsViolation += initDynamicsViolation;
+          performance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+        }
+        return performance;
+      },
+      settings_.printLinesearch, deltaXnorm, deltaUnorm);
+
+  if (accepted >= 0) {  // Return if step accepted
+    const auto& candidate = speculativeLinesearch_.getCandidates()[accepted];
+    x.swap(xNew[accepted]);
+    u.swap(uNew[accepted]);
+    metrics.swap(metricsNew[accepted]);
+
+    // Prepare step info
+    sqp::StepInfo stepInfo;
+    stepInfo.stepSize = candidate.stepSize;
+    stepInfo.stepType = candidate.stepType;
+    stepInfo.dx_norm = candidate.stepSize * deltaXnorm;
+    stepInfo.du_norm = candidate.stepSize * deltaUnorm;
+    stepInfo.performanceAfterStep = candidate.performance;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(candidate.performance);
+    return stepInfo;
+  }
+
+  // Alpha_min reached -> Don't take a step
+  sqp::StepInfo stepInfo;
+  stepInfo.stepSize = 0.0;
+  stepInfo.stepType = StepType::ZERO;
+  stepInfo.dx_norm = 0.0;
+  stepInfo.du_norm = 0.0;
+  stepInfo.performanceAfterStep = baseline;
+  stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+
+  if (settings_.printLinesearch) {
+    std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+  }
+
+  return stepInfo;
+}
+
 sqp::Convergence SqpSolver::checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const {
   using Convergence = sqp::Convergence;
   if ((iteration + 1) >= settings_.sqpIteration) {
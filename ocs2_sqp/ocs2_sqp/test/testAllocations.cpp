@@ -0,0 +1,101 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <hpipm_catkin/HpipmInterface.h>
+
+#include <ocs2_core/test/AllocationFreeTest.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+using namespace ocs2;
+
+/**
+ * Steady-state QP step of an SQP iteration, as in SqpSolver::getOCPSolution(). The linear quadratic approximation of the iteration is
+ * not covered: the cost, dynamics, and constraint interfaces return their approximations by value.
+ */
+class SqpAllocations : public AllocationFreeTest {
+ protected:
+  static constexpr int N = 20;
+  static constexpr int nx = 4;
+  static constexpr int nu = 3;
+  static constexpr int nc = 1;
+
+  SqpAllocations() : x0(vector_t::Random(nx)) {
+    for (int k = 0; k < N; k++) {
+      dynamics.emplace_back(getRandomDynamics(nx, nu));
+      cost.emplace_back(getRandomCost(nx, nu));
+      constraints.emplace_back(getRandomConstraints(nx, nu, nc));
+    }
+    cost.emplace_back(getRandomCost(nx, 0));
+    constraints.emplace_back(getRandomConstraints(nx, 0, nc));
+  }
+
+  void solveQp(HpipmInterface& hpipmInterface, std::vector<VectorFunctionLinearApproximation>* constraintsPtr) {
+    extractSizesFromProblem(dynamics, cost, constraintsPtr, ocpSize);
+    hpipmInterface.resize(ocpSize);
+    ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, constraintsPtr, deltaXSol, deltaUSol, false), hpipm_status::SUCCESS);
+  }
+
+  void solveWarmStartedQp(HpipmInterface& hpipmInterface) {
+    extractSizesFromProblem(dynamics, cost, &constraints, ocpSize);
+    hpipmInterface.resize(ocpSize);
+    hpipmInterface.setInitialGuess(qpWarmStart);
+    ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, &constraints, deltaXSol, deltaUSol, false), hpipm_status::SUCCESS);
+    hpipmInterface.getSolution(qpWarmStart);
+  }
+
+  const vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  std::vector<VectorFunctionLinearApproximation> constraints;
+
+  OcpSize ocpSize;
+  vector_array_t deltaXSol;
+  vector_array_t deltaUSol;
+  HpipmInterface::Solution qpWarmStart;
+};
+
+TEST_F(SqpAllocations, unconstrainedQpStep) {
+  HpipmInterface hpipmInterface;
+  EXPECT_ALLOCATION_FREE(solveQp(hpipmInterface, nullptr));
+}
+
+TEST_F(SqpAllocations, constrainedQpStep) {
+  HpipmInterface hpipmInterface;
+  EXPECT_ALLOCATION_FREE(solveQp(hpipmInterface, &constraints));
+}
+
+TEST_F(SqpAllocations, warmStartedQpStep) {
+  HpipmInterface::Settings settings;
+  settings.warm_start = 1;
+  HpipmInterface hpipmInterface(OcpSize(), settings);
+  EXPECT_ALLOCATION_FREE(solveWarmStartedQp(hpipmInterface));
+}
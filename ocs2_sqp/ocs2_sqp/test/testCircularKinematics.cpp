@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include "ocs2_sqp/SqpSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
@@ -141,3 +143,129 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+/** Compares the solver options against the default solver on the circular kinematics problem */
+class CircularKinematicsSolverOptions : public ::testing::Test {
+ protected:
+  CircularKinematicsSolverOptions() : problem(ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated")), zeroInitializer(2) {
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = true;
+    settings.useFeedbackPolicy = true;
+    settings.nThreads = 3;
+  }
+
+  /** Constructs a solver with the given settings and solves the problem */
+  std::unique_ptr<ocs2::SqpSolver> solve(const ocs2::sqp::Settings& solverSettings) const {
+    std::unique_ptr<ocs2::SqpSolver> solverPtr(new ocs2::SqpSolver(solverSettings, problem, zeroInitializer));
+    solverPtr->run(startTime, initState, finalTime);
+    return solverPtr;
+  }
+
+  const ocs2::OptimalControlProblem problem;
+  const ocs2::DefaultInitializer zeroInitializer;
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  ocs2::sqp::Settings settings;
+};
+
+TEST_F(CircularKinematicsSolverOptions, speculativeLinesearch) {
+  // Solve with the serial linesearch
+  settings.printLinesearch = true;
+  const auto serialSolver = solve(settings);
+
+  // Solve with several step sizes evaluated in parallel
+  settings.linesearchBatchSize = 4;
+  const auto speculativeSolver = solve(settings);
+
+  // The speculative linesearch picks the same step sizes
+  ASSERT_EQ(speculativeSolver->getNumIterations(), serialSolver->getNumIterations());
+  const auto serialSolution = serialSolver->primalSolution(finalTime);
+  const auto speculativeSolution = speculativeSolver->primalSolution(finalTime);
+  ASSERT_EQ(speculativeSolution.stateTrajectory_.size(), serialSolution.stateTrajectory_.size());
+  for (size_t i = 0; i < serialSolution.stateTrajectory_.size(); i++) {
+    ASSERT_TRUE(speculativeSolution.stateTrajectory_[i].isApprox(serialSolution.stateTrajectory_[i], 1e-6));
+  }
+
+  // Check constraint satisfaction.
+  const auto performance = speculativeSolver->getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+}
+
+TEST_F(CircularKinematicsSolverOptions, linearizeFullStep) {
+  // Solve with a separate linearization in every iteration
+  const auto solver = solve(settings);
+
+  // Solve with the linearization of the accepted full steps reused
+  settings.linearizeFullStep = true;
+  const auto reusingSolver = solve(settings);
+
+  // Same iterates
+  ASSERT_EQ(reusingSolver->getNumIterations(), solver->getNumIterations());
+  ASSERT_EQ(solver->getNumRejectedFullStepLinearizations(), 0);
+  ASSERT_LE(reusingSolver->getNumRejectedFullStepLinearizations(), reusingSolver->getNumIterations());
+  const auto& iterationsLog = solver->getIterationsLog();
+  const auto& reusingIterationsLog = reusingSolver->getIterationsLog();
+  for (size_t i = 0; i < iterationsLog.size(); i++) {
+    ASSERT_NEAR(reusingIterationsLog[i].merit, iterationsLog[i].merit, 1e-9);
+  }
+  const auto solution = solver->primalSolution(finalTime);
+  const auto reusingSolution = reusingSolver->primalSolution(finalTime);
+  for (size_t i = 0; i < solution.stateTrajectory_.size(); i++) {
+    ASSERT_TRUE(reusingSolution.stateTrajectory_[i].isApprox(solution.stateTrajectory_[i], 1e-9));
+  }
+}
+
+TEST_F(CircularKinematicsSolverOptions, inexactLinearization) {
+  // Solve with all nodes linearized in every iteration
+  settings.sqpIteration = 50;
+  const auto solver = solve(settings);
+
+  // Solve with the sensitivities kept for nodes that barely move
+  settings.relinearizationThreshold = 1e-3;
+  const auto inexactSolver = solve(settings);
+
+  // Linearizations were skipped
+  ASSERT_EQ(solver->getNumSkippedLinearizations(), 0);
+  ASSERT_GT(inexactSolver->getNumSkippedLinearizations(), 0);
+
+  // Feasible, and close to the solution with exact linearizations
+  const auto& performance = inexactSolver->getIterationsLog().back();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+  const auto solution = solver->primalSolution(finalTime);
+  const auto inexactSolution = inexactSolver->primalSolution(finalTime);
+  for (size_t i = 0; i < solution.stateTrajectory_.size(); i++) {
+    ASSERT_TRUE(inexactSolution.stateTrajectory_[i].isApprox(solution.stateTrajectory_[i], 1e-4));
+    ASSERT_TRUE(inexactSolution.inputTrajectory_[i].isApprox(solution.inputTrajectory_[i], 1e-4));
+  }
+}
+
+TEST_F(CircularKinematicsSolverOptions, warmStartedQp) {
+  // Pass the state-input constraints to HPIPM, and solve a shifted horizon first as in MPC
+  settings.projectStateInputEqualityConstraints = false;
+  const auto solveShifted = [&](const ocs2::sqp::Settings& solverSettings) {
+    std::unique_ptr<ocs2::SqpSolver> solverPtr(new ocs2::SqpSolver(solverSettings, problem, zeroInitializer));
+    solverPtr->run(startTime - 0.05, initState, finalTime - 0.05);
+    solverPtr->run(startTime, initState, finalTime);
+    return solverPtr;
+  };
+
+  // Solve with cold started QPs
+  const auto solver = solveShifted(settings);
+
+  // Solve with QPs warm started from the previous primal QP solution, also across the shifted horizon
+  settings.hpipmSettings.warm_start = 1;
+  const auto warmStartSolver = solveShifted(settings);
+
+  // Same solution. The number of interior point iterations depends on the HPIPM version, and is not compared.
+  ASSERT_GT(warmStartSolver->getNumQpIterations(), 0);
+  const auto solution = solver->primalSolution(finalTime);
+  const auto warmStartSolution = warmStartSolver->primalSolution(finalTime);
+  ASSERT_EQ(warmStartSolution.timeTrajectory_.size(), solution.timeTrajectory_.size());
+  for (size_t i = 0; i < solution.stateTrajectory_.size(); i++) {
+    ASSERT_TRUE(warmStartSolution.stateTrajectory_[i].isApprox(solution.stateTrajectory_[i], 1e-4));
+  }
+}
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include "ocs2_sqp/SqpMpc.h"
 #include "ocs2_sqp/SqpSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
@@ -41,7 +42,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSetting(
     bool feedback, bool emptyConstraint, const VectorFunctionLinearApproximation& dynamicsMatrices,
-    const ScalarFunctionQuadraticApproximation& costMatrices) {
+    const ScalarFunctionQuadraticApproximation& costMatrices, bool realTimeIteration = false) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -76,6 +77,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
   settings.nThreads = 100;
+  settings.realTimeIteration = realTimeIteration;
 
   // Additional problem definitions
   const ocs2::scalar_t startTime = 0.0;
@@ -86,7 +88,13 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   ocs2::SqpSolver solver(settings, problem, zeroInitializer);
   solver.setReferenceManager(referenceManagerPtr);
 
-  // Solve
+  // Solve. The real-time iteration is prepared with a wrong initial state, which is corrected in the feedback phase, and a wrong target,
+  // which is updated before the feedback phase.
+  if (realTimeIteration) {
+    referenceManagerPtr->setTargetTrajectories(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(n)}, {ocs2::vector_t::Zero(m)}));
+    solver.prepareRun(startTime, ocs2::vector_t::Zero(n), finalTime);
+    referenceManagerPtr->setTargetTrajectories(targetTrajectories);
+  }
   solver.run(startTime, initState, finalTime);
   return {solver.primalSolution(finalTime), solver.getIterationsLog()};
 }
@@ -160,3 +168,75 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, realTimeIteration) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto sqpSolution = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs);
+  const auto rtiSolution = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs, true);
+
+  // A single full QP step solves the linear quadratic problem
+  ASSERT_EQ(rtiSolution.second.size(), 1);
+  const auto& withSqp = sqpSolution.first;
+  const auto& withRti = rtiSolution.first;
+  ASSERT_EQ(withRti.timeTrajectory_.size(), withSqp.timeTrajectory_.size());
+  for (size_t i = 0; i < withSqp.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withRti.timeTrajectory_[i], withSqp.timeTrajectory_[i]);
+    ASSERT_TRUE(withRti.stateTrajectory_[i].isApprox(withSqp.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withRti.inputTrajectory_[i].isApprox(withSqp.inputTrajectory_[i], tol));
+  }
+}
+
+TEST(test_unconstrained, realTimeIterationMpc) {
+  int n = 3;
+  int m = 2;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.realTimeIteration = true;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  ocs2::SqpMpc mpc(mpcSettings, settings, problem, zeroInitializer);
+  mpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+  const ocs2::vector_t initState = ocs2::vector_t::Ones(n);
+
+  // The time of the next observation is not known after the first run
+  mpc.run(0.0, initState);
+  mpc.prepareNextRun();
+  ASSERT_FALSE(mpc.getSolverPtr()->isRealTimeIterationPrepared(0.0, 1.0));
+
+  // After the second run, the next observation is expected one period later
+  mpc.run(0.02, initState);
+  mpc.prepareNextRun();
+  ASSERT_TRUE(mpc.getSolverPtr()->isRealTimeIterationPrepared(0.04, 1.04));
+  ASSERT_FALSE(mpc.getSolverPtr()->isRealTimeIterationPrepared(0.04, 1.04 + settings.dt));
+
+  // The policy starts at the actual initial time
+  mpc.run(0.035, initState);
+  const auto solution = mpc.getSolverPtr()->primalSolution(1.035);
+  ASSERT_DOUBLE_EQ(solution.timeTrajectory_.front(), 0.035);
+  ASSERT_DOUBLE_EQ(solution.timeTrajectory_.back(), 1.035);
+
+  // An update of the target invalidates the preparation
+  mpc.prepareNextRun();
+  ASSERT_TRUE(mpc.getSolverPtr()->isRealTimeIterationPrepared(0.05, 1.05));
+  referenceManagerPtr->setTargetTrajectories(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(n)}, {ocs2::vector_t::Zero(m)}));
+  referenceManagerPtr->preSolverRun(0.05, 1.05, initState);
+  ASSERT_FALSE(mpc.getSolverPtr()->isRealTimeIterationPrepared(0.05, 1.05));
+}